@@ -694,6 +694,68 @@ void lcContext::DestroyRenderFramebuffer(std::pair<lcFramebuffer, lcFramebuffer>
 	DestroyFramebuffer(RenderFramebuffer.second);
 }
 
+/*** LPub3D Mod - incremental render ***/
+// Framebuffer objects are not shared between contexts but their attachments are,
+// so a retained render framebuffer keeps its texture and depth renderbuffer and
+// is given new framebuffer objects by the context that renders to it next.
+void lcContext::ReleaseRenderFramebuffer(std::pair<lcFramebuffer, lcFramebuffer>& RenderFramebuffer)
+{
+	if (gSupportsFramebufferObjectARB)
+	{
+		glDeleteFramebuffers(1, &RenderFramebuffer.first.mObject);
+		glDeleteFramebuffers(1, &RenderFramebuffer.second.mObject);
+	}
+
+	RenderFramebuffer.first.mObject = 0;
+	RenderFramebuffer.second.mObject = 0;
+}
+
+bool lcContext::RestoreRenderFramebuffer(std::pair<lcFramebuffer, lcFramebuffer>& RenderFramebuffer)
+{
+	if (!gSupportsFramebufferObjectARB || !RenderFramebuffer.first.mColorTexture)
+		return false;
+
+	auto RestoreFramebuffer = [](lcFramebuffer& Framebuffer, bool Multisample)
+	{
+		GLenum TextureTarget = GL_TEXTURE_2D;
+#ifndef LC_OPENGLES
+		if (Multisample)
+			TextureTarget = GL_TEXTURE_2D_MULTISAMPLE;
+#else
+		Q_UNUSED(Multisample);
+#endif
+
+		glGenFramebuffers(1, &Framebuffer.mObject);
+		glBindFramebuffer(GL_FRAMEBUFFER, Framebuffer.mObject);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, TextureTarget, Framebuffer.mColorTexture, 0);
+
+		if (Framebuffer.mDepthRenderbuffer)
+			glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, Framebuffer.mDepthRenderbuffer);
+
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		{
+			glDeleteFramebuffers(1, &Framebuffer.mObject);
+			Framebuffer.mObject = 0;
+		}
+
+		return Framebuffer.mObject != 0;
+	};
+
+	const bool Multisample = RenderFramebuffer.second.mColorTexture != 0;
+	bool Restored = RestoreFramebuffer(RenderFramebuffer.first, Multisample && gSupportsTexImage2DMultisample);
+
+	if (Restored && Multisample)
+		Restored = RestoreFramebuffer(RenderFramebuffer.second, false);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, mFramebufferObject);
+
+	if (!Restored)
+		ReleaseRenderFramebuffer(RenderFramebuffer);
+
+	return Restored;
+}
+/*** LPub3D Mod end ***/
+
 QImage lcContext::GetRenderFramebufferImage(const std::pair<lcFramebuffer, lcFramebuffer>& RenderFramebuffer)
 {
 	QImage Image(RenderFramebuffer.first.mWidth, RenderFramebuffer.first.mHeight, QImage::Format_ARGB32);
@@ -836,6 +898,46 @@ void lcContext::DestroyIndexBuffer(lcIndexBuffer& IndexBuffer)
 	IndexBuffer.Pointer = nullptr;
 }
 
+/*** LPub3D Mod - mesh buffer arena ***/
+void lcContext::UpdateVertexBuffer(lcVertexBuffer VertexBuffer, int Offset, int Size, const void* Data)
+{
+	if (!VertexBuffer.IsValid())
+		return;
+
+	if (gSupportsVertexBufferObject)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER_ARB, VertexBuffer.Object);
+		glBufferSubData(GL_ARRAY_BUFFER_ARB, Offset, Size, Data);
+
+		glBindBuffer(GL_ARRAY_BUFFER_ARB, 0); // context remove
+		mVertexBufferObject = 0;
+	}
+	else
+	{
+		memcpy((char*)VertexBuffer.Pointer + Offset, Data, Size);
+	}
+}
+
+void lcContext::UpdateIndexBuffer(lcIndexBuffer IndexBuffer, int Offset, int Size, const void* Data)
+{
+	if (!IndexBuffer.IsValid())
+		return;
+
+	if (gSupportsVertexBufferObject)
+	{
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, IndexBuffer.Object);
+		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER_ARB, Offset, Size, Data);
+
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0); // context remove
+		mIndexBufferObject = 0;
+	}
+	else
+	{
+		memcpy((char*)IndexBuffer.Pointer + Offset, Data, Size);
+	}
+}
+/*** LPub3D Mod end ***/
+
 void lcContext::ClearVertexBuffer()
 {
 	mVertexBufferPointer = nullptr;
@@ -195,6 +195,10 @@ public:
 
 	std::pair<lcFramebuffer, lcFramebuffer> CreateRenderFramebuffer(int Width, int Height);
 	void DestroyRenderFramebuffer(std::pair<lcFramebuffer, lcFramebuffer>& RenderFramebuffer);
+/*** LPub3D Mod - incremental render ***/
+	void ReleaseRenderFramebuffer(std::pair<lcFramebuffer, lcFramebuffer>& RenderFramebuffer);
+	bool RestoreRenderFramebuffer(std::pair<lcFramebuffer, lcFramebuffer>& RenderFramebuffer);
+/*** LPub3D Mod end ***/
 	QImage GetRenderFramebufferImage(const std::pair<lcFramebuffer, lcFramebuffer>& RenderFramebuffer);
 	void GetRenderFramebufferImage(const std::pair<lcFramebuffer, lcFramebuffer>& RenderFramebuffer, quint8* Buffer);
 
@@ -202,6 +206,10 @@ public:
 	void DestroyVertexBuffer(lcVertexBuffer& VertexBuffer);
 	lcIndexBuffer CreateIndexBuffer(int Size, const void* Data);
 	void DestroyIndexBuffer(lcIndexBuffer& IndexBuffer);
+/*** LPub3D Mod - mesh buffer arena ***/
+	void UpdateVertexBuffer(lcVertexBuffer VertexBuffer, int Offset, int Size, const void* Data);
+	void UpdateIndexBuffer(lcIndexBuffer IndexBuffer, int Offset, int Size, const void* Data);
+/*** LPub3D Mod end ***/
 
 	void ClearVertexBuffer();
 	void SetVertexBuffer(lcVertexBuffer VertexBuffer);
@@ -36,6 +36,9 @@
 /*** LPub3D Mod - part types ***/
 #define LC_LIBRARY_PART_TYPE       1
 /*** LPub3D Mod end ***/
+/*** LPub3D Mod - sub-file mesh cache ***/
+#define LC_SUBFILE_MESH_CACHE_SIZE 131072 // KB
+/*** LPub3D Mod end ***/
 
 lcPiecesLibrary::lcPiecesLibrary()
 	: mLoadMutex(QMutex::Recursive)
@@ -64,6 +67,9 @@ lcPiecesLibrary::lcPiecesLibrary()
 	mHasUnofficial = false;
 	mCancelLoading = false;
 	mStudLogo = lcGetProfileInt(LC_PROFILE_STUD_LOGO);
+/*** LPub3D Mod - sub-file mesh cache ***/
+	mSubFileMeshes.setMaxCost(LC_SUBFILE_MESH_CACHE_SIZE);
+/*** LPub3D Mod end ***/
 }
 
 lcPiecesLibrary::~lcPiecesLibrary()
@@ -78,6 +84,16 @@ lcPiecesLibrary::~lcPiecesLibrary()
 
 void lcPiecesLibrary::Unload()
 {
+/*** LPub3D Mod - preload model parts ***/
+	mPreloadedPieces.clear();
+/*** LPub3D Mod end ***/
+/*** LPub3D Mod - category index ***/
+	mCategoryEntries.clear();
+/*** LPub3D Mod end ***/
+/*** LPub3D Mod - sub-file mesh cache ***/
+	ClearSubFileMeshCache();
+/*** LPub3D Mod end ***/
+
 	for (const auto& PieceIt : mPieces)
 		delete PieceIt.second;
 	mPieces.clear();
@@ -109,6 +125,9 @@ void lcPiecesLibrary::RemoveTemporaryPieces()
 		{
 			PieceIt = mPieces.erase(PieceIt);
 			delete Info;
+/*** LPub3D Mod - category index ***/
+			mCategoryEntries.clear();
+/*** LPub3D Mod end ***/
 		}
 		else
 			PieceIt++;
@@ -126,6 +145,9 @@ void lcPiecesLibrary::RemovePiece(PieceInfo* Info)
 		}
 	}
 	delete Info;
+/*** LPub3D Mod - category index ***/
+	mCategoryEntries.clear();
+/*** LPub3D Mod end ***/
 }
 
 void lcPiecesLibrary::RenamePiece(PieceInfo* Info, const char* NewName)
@@ -149,6 +171,9 @@ void lcPiecesLibrary::RenamePiece(PieceInfo* Info, const char* NewName)
 	strupr(PieceName);
 
 	mPieces[PieceName] = Info;
+/*** LPub3D Mod - category index ***/
+	mCategoryEntries.clear();
+/*** LPub3D Mod end ***/
 }
 
 PieceInfo* lcPiecesLibrary::FindPiece(const char* PieceName, Project* CurrentProject, bool CreatePlaceholder, bool SearchProjectFolder)
@@ -1246,6 +1271,36 @@ void lcPiecesLibrary::WaitForLoadQueue()
 	mLoadFutures.clear();
 }
 
+/*** LPub3D Mod - preload model parts ***/
+void lcPiecesLibrary::PreloadPieces(const QStringList& PieceNames)
+{
+	ReleasePreloadedPieces();
+
+	for (const QString& PieceName : PieceNames)
+	{
+		PieceInfo* Info = FindPiece(PieceName.toLatin1().constData(), nullptr, false, false);
+
+		if (!Info || Info->IsTemporary() || Info->IsModel() || Info->IsProject())
+			continue;
+
+		LoadPieceInfo(Info, false, false);
+		mPreloadedPieces.push_back(Info);
+	}
+}
+
+void lcPiecesLibrary::ReleasePreloadedPieces()
+{
+	if (mPreloadedPieces.empty())
+		return;
+
+	WaitForLoadQueue();
+
+	for (PieceInfo* Info : mPreloadedPieces)
+		ReleasePieceInfo(Info);
+	mPreloadedPieces.clear();
+}
+/*** LPub3D Mod end ***/
+
 bool lcPiecesLibrary::LoadPieceData(PieceInfo* Info)
 {
 	lcLibraryMeshData MeshData;
@@ -1264,7 +1319,11 @@ bool lcPiecesLibrary::LoadPieceData(PieceInfo* Info)
 		if (mZipFiles[Info->mZipFileType]->ExtractFile(Info->mZipFileIndex, PieceFile))
 			Loaded = MeshLoader.LoadMesh(PieceFile, LC_MESHDATA_SHARED);
 
-		SaveCache = Loaded && (Info->mZipFileType == LC_ZIPFILE_OFFICIAL);
+/*** LPub3D Mod - cache unofficial parts ***/
+		// the unofficial archive holds the custom, fade, highlight and search
+		// directory parts - the cache checksum covers both archives
+		SaveCache = Loaded;
+/*** LPub3D Mod end ***/
 	}
 	else
 	{
@@ -1439,17 +1498,97 @@ void lcPiecesLibrary::ReleaseBuffers(lcContext* Context)
 {
 	Context->DestroyVertexBuffer(mVertexBuffer);
 	Context->DestroyIndexBuffer(mIndexBuffer);
+/*** LPub3D Mod - mesh buffer arena ***/
+	mBufferMeshes.clear();
+/*** LPub3D Mod end ***/
 	mBuffersDirty = true;
 }
 
+/*** LPub3D Mod - mesh buffer arena ***/
+#define LC_BUFFER_ALIGNMENT 4                    // bytes, range offset alignment
+#define LC_BUFFER_MIN_CAPACITY (4 * 1024 * 1024) // bytes, smallest arena buffer
+
+void lcBufferArena::Reset(int Capacity)
+{
+	mCapacity = Capacity;
+	mEnd = 0;
+	mFreeSize = 0;
+	mFreeRanges.clear();
+}
+
+int lcBufferArena::Allocate(int Size)
+{
+	Size = (Size + LC_BUFFER_ALIGNMENT - 1) & ~(LC_BUFFER_ALIGNMENT - 1);
+
+	for (auto RangeIt = mFreeRanges.begin(); RangeIt != mFreeRanges.end(); ++RangeIt)
+	{
+		if (RangeIt->Size < Size)
+			continue;
+
+		const int Offset = RangeIt->Offset;
+		RangeIt->Offset += Size;
+		RangeIt->Size -= Size;
+		mFreeSize -= Size;
+
+		if (!RangeIt->Size)
+			mFreeRanges.erase(RangeIt);
+
+		return Offset;
+	}
+
+	if (mEnd + Size > mCapacity)
+		return -1;
+
+	const int Offset = mEnd;
+	mEnd += Size;
+
+	return Offset;
+}
+
+void lcBufferArena::Free(const lcBufferRange& Range)
+{
+	lcBufferRange Freed = { Range.Offset, (Range.Size + LC_BUFFER_ALIGNMENT - 1) & ~(LC_BUFFER_ALIGNMENT - 1) };
+
+	auto RangeIt = std::lower_bound(mFreeRanges.begin(), mFreeRanges.end(), Freed, [](const lcBufferRange& a, const lcBufferRange& b)
+	{
+		return a.Offset < b.Offset;
+	});
+
+	RangeIt = mFreeRanges.insert(RangeIt, Freed);
+	mFreeSize += Freed.Size;
+
+	if (RangeIt + 1 != mFreeRanges.end() && RangeIt->Offset + RangeIt->Size == (RangeIt + 1)->Offset)
+	{
+		RangeIt->Size += (RangeIt + 1)->Size;
+		mFreeRanges.erase(RangeIt + 1);
+	}
+
+	if (RangeIt != mFreeRanges.begin() && (RangeIt - 1)->Offset + (RangeIt - 1)->Size == RangeIt->Offset)
+	{
+		(RangeIt - 1)->Size += RangeIt->Size;
+		RangeIt = mFreeRanges.erase(RangeIt) - 1;
+	}
+
+	if (RangeIt->Offset + RangeIt->Size == mEnd)
+	{
+		mEnd = RangeIt->Offset;
+		mFreeSize -= RangeIt->Size;
+		mFreeRanges.erase(RangeIt);
+	}
+}
+
+// Meshes are placed in pooled vertex and index buffers. Newly loaded meshes
+// are appended to free ranges with sub-data uploads and the ranges of
+// released meshes are recycled; the buffers are only reallocated and
+// repacked when they run out of room or become mostly free space.
 void lcPiecesLibrary::UpdateBuffers(lcContext* Context)
 {
 	if (!gSupportsVertexBufferObject || !mBuffersDirty)
 		return;
 
-	int VertexDataSize = 0;
-	int IndexDataSize = 0;
-	std::vector<lcMesh*> Meshes;
+	std::vector<lcMesh*> LiveMeshes;
+	std::vector<lcMesh*> NewMeshes;
+	std::set<const lcMesh*> LiveMeshSet;
 
 	for (const auto& PieceIt : mPieces)
 	{
@@ -1462,43 +1601,141 @@ void lcPiecesLibrary::UpdateBuffers(lcContext* Context)
 		if (Mesh->mVertexDataSize > 16 * 1024 * 1024 || Mesh->mIndexDataSize > 16 * 1024 * 1024)
 			continue;
 
-		VertexDataSize += Mesh->mVertexDataSize;
-		IndexDataSize += Mesh->mIndexDataSize;
+		if (!LiveMeshSet.insert(Mesh).second)
+			continue;
+
+		LiveMeshes.push_back(Mesh);
+
+		const auto MeshIt = mBufferMeshes.find(Mesh);
+
+		if (MeshIt != mBufferMeshes.end())
+		{
+			if (Mesh->mVertexCacheOffset != -1)
+				continue;
+
+			// a new mesh allocated at the address of a released one
+			mVertexArena.Free(MeshIt->second.Vertex);
+			mIndexArena.Free(MeshIt->second.Index);
+			mBufferMeshes.erase(MeshIt);
+		}
+
+		NewMeshes.push_back(Mesh);
+	}
+
+	for (auto MeshIt = mBufferMeshes.begin(); MeshIt != mBufferMeshes.end(); )
+	{
+		if (LiveMeshSet.find(MeshIt->first) == LiveMeshSet.end())
+		{
+			mVertexArena.Free(MeshIt->second.Vertex);
+			mIndexArena.Free(MeshIt->second.Index);
+			MeshIt = mBufferMeshes.erase(MeshIt);
+		}
+		else
+			++MeshIt;
+	}
+
+	mBuffersDirty = false;
+
+	if (NewMeshes.empty())
+		return;
+
+	bool Rebuild = !mVertexBuffer.IsValid() || !mIndexBuffer.IsValid() ||
+	               mVertexArena.GetFreeSize() > mVertexArena.GetUsedSize() ||
+	               mIndexArena.GetFreeSize() > mIndexArena.GetUsedSize();
+
+	if (!Rebuild)
+	{
+		std::vector<lcMeshBufferRanges> NewRanges;
+		NewRanges.reserve(NewMeshes.size());
+
+		for (const lcMesh* Mesh : NewMeshes)
+		{
+			lcMeshBufferRanges Ranges;
+			Ranges.Vertex = { mVertexArena.Allocate(Mesh->mVertexDataSize), Mesh->mVertexDataSize };
+			Ranges.Index = { mIndexArena.Allocate(Mesh->mIndexDataSize), Mesh->mIndexDataSize };
+
+			if (Ranges.Vertex.Offset == -1 || Ranges.Index.Offset == -1)
+			{
+				Rebuild = true;
+				break;
+			}
+
+			NewRanges.push_back(Ranges);
+		}
+
+		if (!Rebuild)
+		{
+			for (size_t MeshIdx = 0; MeshIdx < NewMeshes.size(); MeshIdx++)
+			{
+				lcMesh* Mesh = NewMeshes[MeshIdx];
+				const lcMeshBufferRanges& Ranges = NewRanges[MeshIdx];
+
+				Context->UpdateVertexBuffer(mVertexBuffer, Ranges.Vertex.Offset, Ranges.Vertex.Size, Mesh->mVertexData);
+				Context->UpdateIndexBuffer(mIndexBuffer, Ranges.Index.Offset, Ranges.Index.Size, Mesh->mIndexData);
 
-		Meshes.push_back(Mesh);
+				Mesh->mVertexCacheOffset = Ranges.Vertex.Offset;
+				Mesh->mIndexCacheOffset = Ranges.Index.Offset;
+				mBufferMeshes[Mesh] = Ranges;
+			}
+
+			return;
+		}
+	}
+
+	RebuildBuffers(Context, LiveMeshes);
+}
+
+// Pack all live meshes into new buffers sized with room to append
+void lcPiecesLibrary::RebuildBuffers(lcContext* Context, const std::vector<lcMesh*>& Meshes)
+{
+	int VertexDataSize = 0;
+	int IndexDataSize = 0;
+
+	for (const lcMesh* Mesh : Meshes)
+	{
+		VertexDataSize += (Mesh->mVertexDataSize + LC_BUFFER_ALIGNMENT - 1) & ~(LC_BUFFER_ALIGNMENT - 1);
+		IndexDataSize += (Mesh->mIndexDataSize + LC_BUFFER_ALIGNMENT - 1) & ~(LC_BUFFER_ALIGNMENT - 1);
 	}
 
 	Context->DestroyVertexBuffer(mVertexBuffer);
 	Context->DestroyIndexBuffer(mIndexBuffer);
+	mBufferMeshes.clear();
 
 	if (!VertexDataSize || !IndexDataSize)
 		return;
 
-	void* VertexData = malloc(VertexDataSize);
-	void* IndexData = malloc(IndexDataSize);
+	const int VertexCapacity = qMax(VertexDataSize + VertexDataSize / 2, LC_BUFFER_MIN_CAPACITY);
+	const int IndexCapacity = qMax(IndexDataSize + IndexDataSize / 2, LC_BUFFER_MIN_CAPACITY);
+
+	mVertexArena.Reset(VertexCapacity);
+	mIndexArena.Reset(IndexCapacity);
 
-	VertexDataSize = 0;
-	IndexDataSize = 0;
+	char* VertexData = (char*)malloc(VertexDataSize);
+	char* IndexData = (char*)malloc(IndexDataSize);
 
 	for (lcMesh* Mesh : Meshes)
 	{
-		Mesh->mVertexCacheOffset = VertexDataSize;
-		Mesh->mIndexCacheOffset = IndexDataSize;
+		lcMeshBufferRanges Ranges;
+		Ranges.Vertex = { mVertexArena.Allocate(Mesh->mVertexDataSize), Mesh->mVertexDataSize };
+		Ranges.Index = { mIndexArena.Allocate(Mesh->mIndexDataSize), Mesh->mIndexDataSize };
 
-		memcpy((char*)VertexData + VertexDataSize, Mesh->mVertexData, Mesh->mVertexDataSize);
-		memcpy((char*)IndexData + IndexDataSize, Mesh->mIndexData, Mesh->mIndexDataSize);
+		memcpy(VertexData + Ranges.Vertex.Offset, Mesh->mVertexData, Mesh->mVertexDataSize);
+		memcpy(IndexData + Ranges.Index.Offset, Mesh->mIndexData, Mesh->mIndexDataSize);
 
-		VertexDataSize += Mesh->mVertexDataSize;
-		IndexDataSize += Mesh->mIndexDataSize;
+		Mesh->mVertexCacheOffset = Ranges.Vertex.Offset;
+		Mesh->mIndexCacheOffset = Ranges.Index.Offset;
+		mBufferMeshes[Mesh] = Ranges;
 	}
 
-	mVertexBuffer = Context->CreateVertexBuffer(VertexDataSize, VertexData);
-	mIndexBuffer = Context->CreateIndexBuffer(IndexDataSize, IndexData);
-	mBuffersDirty = false;
+	mVertexBuffer = Context->CreateVertexBuffer(VertexCapacity, nullptr);
+	mIndexBuffer = Context->CreateIndexBuffer(IndexCapacity, nullptr);
+	Context->UpdateVertexBuffer(mVertexBuffer, 0, VertexDataSize, VertexData);
+	Context->UpdateIndexBuffer(mIndexBuffer, 0, IndexDataSize, IndexData);
 
 	free(VertexData);
 	free(IndexData);
 }
+/*** LPub3D Mod end ***/
 
 void lcPiecesLibrary::UnloadUnusedParts()
 {
@@ -1569,6 +1806,10 @@ void lcPiecesLibrary::SetStudLogo(int StudLogo, bool Reload)
 {
 	mStudLogo = StudLogo;
 
+/*** LPub3D Mod - sub-file mesh cache ***/
+	ClearSubFileMeshCache();
+/*** LPub3D Mod end ***/
+
 	mLoadMutex.lock();
 
 	for (const auto& PrimitiveIt : mPrimitives)
@@ -1734,6 +1975,74 @@ bool lcPiecesLibrary::LoadPrimitive(lcLibraryPrimitive* Primitive)
 	return true;
 }
 
+/*** LPub3D Mod - sub-file mesh cache ***/
+std::shared_ptr<lcLibraryMeshData> lcPiecesLibrary::GetSubFileMeshData(const char* FileName)
+{
+	const QByteArray Key(FileName);
+
+	{
+		QMutexLocker Lock(&mSubFileMeshMutex);
+
+		std::shared_ptr<lcLibraryMeshData>* CachedMeshData = mSubFileMeshes.object(Key);
+
+		if (CachedMeshData)
+			return *CachedMeshData;
+
+		if (mUncachedSubFiles.contains(Key))
+			return nullptr;
+	}
+
+	// model and project pieces can change between loads - cache library parts only
+	const auto PieceIt = mPieces.find(FileName);
+
+	if (PieceIt == mPieces.end() || PieceIt->second->IsTemporary())
+		return nullptr;
+
+	std::shared_ptr<lcLibraryMeshData> MeshData = std::make_shared<lcLibraryMeshData>();
+	lcMeshLoader MeshLoader(*MeshData, true, nullptr, false);
+	bool Loaded = false;
+
+	GetPieceFile(FileName, [&MeshLoader, &Loaded](lcFile& File)
+	{
+		Loaded = MeshLoader.LoadMesh(File, LC_MESHDATA_SHARED);
+	});
+
+	if (!Loaded)
+		return nullptr;
+
+	QMutexLocker Lock(&mSubFileMeshMutex);
+
+	// textured sub-files depend on the texture stack of the including file
+	if (MeshData->mHasTextures)
+	{
+		mUncachedSubFiles.insert(Key);
+		return nullptr;
+	}
+
+	int Size = 0;
+
+	for (int MeshDataIdx = 0; MeshDataIdx < LC_NUM_MESHDATA_TYPES; MeshDataIdx++)
+	{
+		Size += MeshData->mVertices[MeshDataIdx].GetSize() * int(sizeof(lcLibraryMeshVertex));
+
+		for (const lcLibraryMeshSection* Section : MeshData->mSections[MeshDataIdx])
+			Size += Section->mIndices.GetSize() * int(sizeof(quint32));
+	}
+
+	mSubFileMeshes.insert(Key, new std::shared_ptr<lcLibraryMeshData>(MeshData), Size / 1024 + 1);
+
+	return MeshData;
+}
+
+void lcPiecesLibrary::ClearSubFileMeshCache()
+{
+	QMutexLocker Lock(&mSubFileMeshMutex);
+
+	mSubFileMeshes.clear();
+	mUncachedSubFiles.clear();
+}
+/*** LPub3D Mod end ***/
+
 bool lcPiecesLibrary::PieceInCategory(PieceInfo* Info, const char* CategoryKeywords) const
 {
 	if (Info->IsTemporary())
@@ -1759,60 +2068,83 @@ void lcPiecesLibrary::GetCategoryEntries(const char* CategoryKeywords, bool Grou
 	SinglePieces.RemoveAll();
 	GroupedPieces.RemoveAll();
 
-	for (const auto& PieceIt : mPieces)
+/*** LPub3D Mod - category index ***/
+	// Category entries are computed once per keyword expression and reused
+	// until pieces are added, removed or renamed.
+	if (mCategoryPiecesCount != mPieces.size())
 	{
-		PieceInfo* Info = PieceIt.second;
+		mCategoryEntries.clear();
+		mCategoryPiecesCount = mPieces.size();
+	}
 
-		if (!PieceInCategory(Info, CategoryKeywords))
-			continue;
+	const std::pair<std::string, bool> Key(CategoryKeywords, GroupPieces);
+	auto EntriesIt = mCategoryEntries.find(Key);
 
-		if (!GroupPieces)
-		{
-			SinglePieces.Add(Info);
-			continue;
-		}
+	if (EntriesIt == mCategoryEntries.end())
+	{
+		lcCategoryEntries Entries;
+		std::set<PieceInfo*> GroupedSet;
+		std::vector<PieceInfo*> Singles;
 
-		// Check if it's a patterned piece.
-		if (Info->IsPatterned())
+		for (const auto& PieceIt : mPieces)
 		{
-			PieceInfo* Parent;
+			PieceInfo* Info = PieceIt.second;
 
-			// Find the parent of this patterned piece.
-			char ParentName[LC_PIECE_NAME_LEN];
-			strcpy(ParentName, Info->mFileName);
-			*strchr(ParentName, 'P') = '\0';
-			strcat(ParentName, ".dat");
+			if (!PieceInCategory(Info, CategoryKeywords))
+				continue;
 
-			Parent = FindPiece(ParentName, nullptr, false, false);
+			if (!GroupPieces)
+			{
+				Entries.SinglePieces.push_back(Info);
+				continue;
+			}
 
-			if (Parent)
+			// Check if it's a patterned piece.
+			if (Info->IsPatterned())
 			{
-				// Check if the parent was added as a single piece.
-				int Index = SinglePieces.FindIndex(Parent);
+				PieceInfo* Parent;
 
-				if (Index != -1)
-					SinglePieces.RemoveIndex(Index);
+				// Find the parent of this patterned piece.
+				char ParentName[LC_PIECE_NAME_LEN];
+				strcpy(ParentName, Info->mFileName);
+				*strchr(ParentName, 'P') = '\0';
+				strcat(ParentName, ".dat");
 
-				Index = GroupedPieces.FindIndex(Parent);
+				Parent = FindPiece(ParentName, nullptr, false, false);
 
-				if (Index == -1)
-					GroupedPieces.Add(Parent);
+				if (Parent)
+				{
+					if (GroupedSet.insert(Parent).second)
+						Entries.GroupedPieces.push_back(Parent);
+				}
+				else
+				{
+					// Patterned pieces should have a parent but in case they don't just add them anyway.
+					Singles.push_back(Info);
+				}
 			}
 			else
-			{
-				// Patterned pieces should have a parent but in case they don't just add them anyway.
-				SinglePieces.Add(Info);
-			}
+				Singles.push_back(Info);
 		}
-		else
-		{
-			// Check if this piece has already been added to this category by one of its children.
-			const int Index = GroupedPieces.FindIndex(Info);
 
-			if (Index == -1)
-				SinglePieces.Add(Info);
-		}
+		// Pieces grouped under one of their children are not listed as single pieces.
+		for (PieceInfo* Info : Singles)
+			if (GroupedSet.find(Info) == GroupedSet.end())
+				Entries.SinglePieces.push_back(Info);
+
+		EntriesIt = mCategoryEntries.emplace(Key, std::move(Entries)).first;
 	}
+
+	const lcCategoryEntries& Entries = EntriesIt->second;
+
+	SinglePieces.AllocGrow(Entries.SinglePieces.size());
+	for (PieceInfo* Info : Entries.SinglePieces)
+		SinglePieces.Add(Info);
+
+	GroupedPieces.AllocGrow(Entries.GroupedPieces.size());
+	for (PieceInfo* Info : Entries.GroupedPieces)
+		GroupedPieces.Add(Info);
+/*** LPub3D Mod end ***/
 }
 
 void lcPiecesLibrary::GetPatternedPieces(PieceInfo* Parent, lcArray<PieceInfo*>& Pieces) const
@@ -1941,6 +2273,7 @@ bool lcPiecesLibrary::ReloadUnoffLib()
 	//unload unofficial library content
 	delete mZipFiles[LC_ZIPFILE_UNOFFICIAL];
 	mZipFiles[LC_ZIPFILE_UNOFFICIAL] = NULL;
+	ClearSubFileMeshCache();
 
 	//load unofficial library content
 	if (mUnofficialFileName.isEmpty())
@@ -1961,6 +2294,7 @@ void lcPiecesLibrary::UnloadUnofficialLib() {
 	//unload unofficial library content
 	delete mZipFiles[LC_ZIPFILE_UNOFFICIAL];
 	mZipFiles[LC_ZIPFILE_UNOFFICIAL] = nullptr;
+	ClearSubFileMeshCache();
 }
 /*** LPub3D Mod end ***/
 
@@ -1969,5 +2303,6 @@ void lcPiecesLibrary::UnloadOfficialLib() {
 	mNumOfficialPieces = 0;
 	delete mZipFiles[LC_ZIPFILE_OFFICIAL];
 	mZipFiles[LC_ZIPFILE_OFFICIAL] = nullptr;
+	ClearSubFileMeshCache();
 }
 /*** LPub3D Mod end ***/
@@ -5,6 +5,9 @@
 #include "lc_math.h"
 #include "lc_array.h"
 #include "lc_meshloader.h"
+/*** LPub3D Mod - sub-file mesh cache ***/
+#include <memory>
+/*** LPub3D Mod end ***/
 
 class PieceInfo;
 class lcZipFile;
@@ -69,6 +72,56 @@ public:
 	lcLibraryMeshData mMeshData;
 };
 
+/*** LPub3D Mod - mesh buffer arena ***/
+struct lcBufferRange
+{
+	int Offset;
+	int Size;
+};
+
+// Sub-allocates ranges of a fixed capacity GPU buffer. Freed ranges are
+// kept sorted and merged, and reused first fit before the end is extended.
+class lcBufferArena
+{
+public:
+	lcBufferArena()
+		: mCapacity(0), mEnd(0), mFreeSize(0)
+	{
+	}
+
+	void Reset(int Capacity);
+	int Allocate(int Size);
+	void Free(const lcBufferRange& Range);
+
+	int GetCapacity() const
+	{
+		return mCapacity;
+	}
+
+	int GetUsedSize() const
+	{
+		return mEnd - mFreeSize;
+	}
+
+	int GetFreeSize() const
+	{
+		return mFreeSize;
+	}
+
+protected:
+	int mCapacity;
+	int mEnd;
+	int mFreeSize;
+	std::vector<lcBufferRange> mFreeRanges;
+};
+
+struct lcMeshBufferRanges
+{
+	lcBufferRange Vertex;
+	lcBufferRange Index;
+};
+/*** LPub3D Mod end ***/
+
 class lcPiecesLibrary : public QObject
 {
 	Q_OBJECT
@@ -107,6 +160,10 @@ public:
 	bool LoadPieceData(PieceInfo* Info);
 	void LoadQueuedPiece();
 	void WaitForLoadQueue();
+/*** LPub3D Mod - preload model parts ***/
+	void PreloadPieces(const QStringList& PieceNames);
+	void ReleasePreloadedPieces();
+/*** LPub3D Mod end ***/
 
 	lcTexture* FindTexture(const char* TextureName, Project* CurrentProject, bool SearchProjectFolder);
 	bool LoadTexture(lcTexture* Texture);
@@ -138,6 +195,10 @@ public:
 	}
 
 	bool LoadPrimitive(lcLibraryPrimitive* Primitive);
+/*** LPub3D Mod - sub-file mesh cache ***/
+	std::shared_ptr<lcLibraryMeshData> GetSubFileMeshData(const char* FileName);
+	void ClearSubFileMeshCache();
+/*** LPub3D Mod end ***/
 
 	void SetStudLogo(int StudLogo, bool Reload);
 
@@ -172,6 +233,11 @@ public:
 	bool mBuffersDirty;
 	lcVertexBuffer mVertexBuffer;
 	lcIndexBuffer mIndexBuffer;
+/*** LPub3D Mod - mesh buffer arena ***/
+	lcBufferArena mVertexArena;
+	lcBufferArena mIndexArena;
+	std::map<const lcMesh*, lcMeshBufferRanges> mBufferMeshes;
+/*** LPub3D Mod end ***/
 
 signals:
 	void PartLoaded(PieceInfo* Info);
@@ -193,14 +259,35 @@ protected:
 	bool WriteDirectoryCacheFile(const QString& FileName, lcMemFile& CacheFile);
 
 	bool GetStudLogoFile(lcMemFile& PrimFile, int StudLogo, bool OpenStud);
+/*** LPub3D Mod - mesh buffer arena ***/
+	void RebuildBuffers(lcContext* Context, const std::vector<lcMesh*>& Meshes);
+/*** LPub3D Mod end ***/
 
 	QMutex mLoadMutex;
 	QList<QFuture<void>> mLoadFutures;
 	QList<PieceInfo*> mLoadQueue;
+/*** LPub3D Mod - preload model parts ***/
+	std::vector<PieceInfo*> mPreloadedPieces;
+/*** LPub3D Mod end ***/
+/*** LPub3D Mod - category index ***/
+	struct lcCategoryEntries
+	{
+		std::vector<PieceInfo*> SinglePieces;
+		std::vector<PieceInfo*> GroupedPieces;
+	};
+	std::map<std::pair<std::string, bool>, lcCategoryEntries> mCategoryEntries;
+	size_t mCategoryPiecesCount = 0;
+/*** LPub3D Mod end ***/
 
 	QMutex mTextureMutex;
 	std::vector<lcTexture*> mTextureUploads;
 
+/*** LPub3D Mod - sub-file mesh cache ***/
+	QMutex mSubFileMeshMutex;
+	QCache<QByteArray, std::shared_ptr<lcLibraryMeshData>> mSubFileMeshes;
+	QSet<QByteArray> mUncachedSubFiles;
+/*** LPub3D Mod end ***/
+
 	int mStudLogo;
 
 	QString mCachePath;
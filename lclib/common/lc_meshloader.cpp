@@ -1635,13 +1635,39 @@ bool lcMeshLoader::ReadMeshData(lcFile& File, const lcMatrix44& CurrentTransform
 					else
 						mMeshData.AddMeshDataNoDuplicateCheck(Primitive->mMeshData, IncludeTransform, ColorCode, Mirror ^ InvertNext, InvertNext, TextureMap, MeshDataType);
 				}
+/*** LPub3D Mod - sub-file mesh cache ***/
+				else if (!TextureStack.GetSize() && !Primitive->mMeshData.mHasTextures)
+				{
+					// LoadPrimitive already read the sub-file untransformed, merge it like a primitive
+					if (mOptimize)
+						mMeshData.AddMeshData(Primitive->mMeshData, IncludeTransform, ColorCode, Mirror ^ InvertNext, InvertNext, nullptr, MeshDataType);
+					else
+						mMeshData.AddMeshDataNoDuplicateCheck(Primitive->mMeshData, IncludeTransform, ColorCode, Mirror ^ InvertNext, InvertNext, nullptr, MeshDataType);
+				}
+/*** LPub3D Mod end ***/
 				else
 					Library->GetPrimitiveFile(Primitive, FileCallback);
 
 				mMeshData.mHasLogoStud |= Primitive->mMeshData.mHasLogoStud;
 			}
+/*** LPub3D Mod - sub-file mesh cache ***/
 			else
-				Library->GetPieceFile(FileName, FileCallback);
+			{
+				std::shared_ptr<lcLibraryMeshData> SubFileMeshData = !TextureStack.GetSize() ? Library->GetSubFileMeshData(FileName) : nullptr;
+
+				if (SubFileMeshData)
+				{
+					if (mOptimize)
+						mMeshData.AddMeshData(*SubFileMeshData, IncludeTransform, ColorCode, Mirror ^ InvertNext, InvertNext, nullptr, MeshDataType);
+					else
+						mMeshData.AddMeshDataNoDuplicateCheck(*SubFileMeshData, IncludeTransform, ColorCode, Mirror ^ InvertNext, InvertNext, nullptr, MeshDataType);
+
+					mMeshData.mHasLogoStud |= SubFileMeshData->mHasLogoStud;
+				}
+				else
+					Library->GetPieceFile(FileName, FileCallback);
+			}
+/*** LPub3D Mod end ***/
 		} break;
 
 		case 2:
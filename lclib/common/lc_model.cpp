@@ -1702,30 +1702,9 @@ QImage lcModel::GetPartsListImage(int MaxWidth, lcStep Step) const
 
 	auto CalculateImageBounds = [](lcPartsListImage& Image)
 	{
-		QImage& Thumbnail = Image.Thumbnail;
-		int Width = Thumbnail.width();
-		int Height = Thumbnail.height();
-
-		int MinX = Width;
-		int MinY = Height;
-		int MaxX = 0;
-		int MaxY = 0;
-
-		for (int x = 0; x < Width; x++)
-		{
-			for (int y = 0; y < Height; y++)
-			{
-				if (qAlpha(Thumbnail.pixel(x, y)))
-				{
-					MinX = qMin(x, MinX);
-					MinY = qMin(y, MinY);
-					MaxX = qMax(x, MaxX);
-					MaxY = qMax(y, MaxY);
-				}
-			}
-		}
-
-		Image.Bounds = QRect(QPoint(MinX, MinY), QPoint(MaxX, MaxY));
+/*** LPub3D Mod - image bounds ***/
+		Image.Bounds = lcGetImageAlphaBounds(Image.Thumbnail);
+/*** LPub3D Mod end ***/
 	};
 
 	QtConcurrent::blockingMap(Images, CalculateImageBounds);
@@ -64,6 +64,15 @@ lcPartSelectionListModel::lcPartSelectionListModel(QObject* Parent)
 	}
 
 	connect(lcGetPiecesLibrary(), SIGNAL(PartLoaded(PieceInfo*)), this, SLOT(PartLoaded(PieceInfo*)));
+/*** LPub3D Mod - part search index ***/
+	// The view shows every row again after a reset so the search state starts over.
+	connect(this, &QAbstractItemModel::modelReset, [this]()
+	{
+		mSearchKeys.clear();
+		mHiddenRows.clear();
+		mAppliedFilter.clear();
+	});
+/*** LPub3D Mod end ***/
 }
 
 lcPartSelectionListModel::~lcPartSelectionListModel()
@@ -259,8 +268,48 @@ void lcPartSelectionListModel::SetFilter(const QString& Filter)
 {
 	mFilter = Filter.toLatin1();
 
+/*** LPub3D Mod - part search index ***/
+	// Build the lower case search keys once per part list so each keystroke
+	// only runs a plain substring test per row.
+	if (mSearchKeys.size() != mParts.size())
+	{
+		mSearchKeys.clear();
+		mSearchKeys.reserve(mParts.size());
+
+		for (const std::pair<PieceInfo*, QPixmap>& Part : mParts)
+		{
+			const PieceInfo* Info = Part.first;
+			QByteArray Key;
+			Key.reserve(sizeof(Info->m_strDescription) + sizeof(Info->mFileName));
+
+			for (const char* Src = Info->m_strDescription; *Src; Src++)
+				if (*Src != ' ' || *(Src + 1) != ' ')
+					Key.append(*Src);
+
+			Key.append('\n');
+			Key.append(Info->mFileName);
+
+			mSearchKeys.emplace_back(Key.toLower());
+		}
+	}
+
+	if (mHiddenRows.size() != mParts.size())
+	{
+		mHiddenRows.assign(mParts.size(), false);
+		mAppliedFilter.clear();
+	}
+
+	const QByteArray SearchFilter = mFilter.toLower();
+
+	// Typing more characters can only hide rows, so rows already hidden by the
+	// previous filter do not need to be tested again.
+	const bool Narrowing = !mAppliedFilter.isEmpty() && SearchFilter.size() > mAppliedFilter.size() && SearchFilter.contains(mAppliedFilter);
+
 	for (size_t PartIdx = 0; PartIdx < mParts.size(); PartIdx++)
 	{
+		if (Narrowing && mHiddenRows[PartIdx])
+			continue;
+
 		PieceInfo* Info = mParts[PartIdx].first;
 		bool Visible;
 
@@ -268,32 +317,20 @@ void lcPartSelectionListModel::SetFilter(const QString& Filter)
 			Visible = false;
 		else if (!mShowPartAliases && Info->m_strDescription[0] == '=')
 			Visible = false;
-		else if (mFilter.isEmpty())
+		else if (SearchFilter.isEmpty())
 			Visible = true;
 		else
-		{
-			char Description[sizeof(Info->m_strDescription)];
-			char* Src = Info->m_strDescription;
-			char* Dst = Description;
-
-			for (;;)
-			{
-				*Dst = *Src;
+			Visible = mSearchKeys[PartIdx].contains(SearchFilter);
 
-				if (*Src == ' ' && *(Src + 1) == ' ')
-					Src++;
-				else if (*Src == 0)
-					break;
-
-				Src++;
-				Dst++;
-			}
-
-			Visible = strcasestr(Description, mFilter) || strcasestr(Info->mFileName, mFilter);
+		if (mHiddenRows[PartIdx] != !Visible)
+		{
+			mHiddenRows[PartIdx] = !Visible;
+			mListView->setRowHidden((int)PartIdx, !Visible);
 		}
-
-		mListView->setRowHidden((int)PartIdx, !Visible);
 	}
+
+	mAppliedFilter = SearchFilter;
+/*** LPub3D Mod end ***/
 }
 
 int lcPartSelectionListModel::rowCount(const QModelIndex& Parent) const
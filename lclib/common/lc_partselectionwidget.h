@@ -136,6 +136,11 @@ protected:
 	bool mShowDecoratedParts;
 	bool mShowPartAliases;
 	QByteArray mFilter;
+/*** LPub3D Mod - part search index ***/
+	std::vector<QByteArray> mSearchKeys;
+	std::vector<bool> mHiddenRows;
+	QByteArray mAppliedFilter;
+/*** LPub3D Mod end ***/
 	std::pair<lcFramebuffer, lcFramebuffer> mRenderFramebuffer;
 };
 
@@ -98,6 +98,13 @@ public:
 	void Draw(lcContext* Context) const;
 	void DrawInterfaceObjects(lcContext* Context) const;
 
+/*** LPub3D Mod - incremental render ***/
+	bool HasTranslucentMeshes() const
+	{
+		return !mTranslucentMeshes.IsEmpty();
+	}
+/*** LPub3D Mod end ***/
+
 protected:
 	void DrawOpaqueMeshes(lcContext* Context, bool DrawLit, int PrimitiveTypes, bool DrawFaded, bool DrawNonFaded) const;
 /*** LPub3D Mod - true fade ***/
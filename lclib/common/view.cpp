@@ -15,6 +15,9 @@
 /*** LPub3D Mod - Rotate Step ***/
 #include "lpub.h"
 /*** LPub3D Mod end ***/
+/*** LPub3D Mod - incremental render ***/
+#include "lc_glextensions.h"
+/*** LPub3D Mod end ***/
 
 lcVertexBuffer View::mRotateMoveVertexBuffer;
 lcIndexBuffer View::mRotateMoveIndexBuffer;
@@ -31,6 +34,10 @@ View::View(lcModel* Model)
 	mTrackButton = lcTrackButton::None;
 	mTrackTool = LC_TRACKTOOL_NONE;
 	mTrackToolFromOverlay = false;
+/*** LPub3D Mod - incremental render ***/
+	mRetainedRenderFramebuffer = nullptr;
+	mIncrementalRender = false;
+/*** LPub3D Mod end ***/
 
 	View* ActiveView = gMainWindow->GetActiveView();
 	if (ActiveView)
@@ -840,6 +847,13 @@ lcArray<lcObject*> View::FindObjectsInBox(float x1, float y1, float x2, float y2
 
 bool View::BeginRenderToImage(int Width, int Height)
 {
+/*** LPub3D Mod - incremental render ***/
+	return BeginRenderToImage(Width, Height, nullptr);
+}
+
+bool View::BeginRenderToImage(int Width, int Height, std::pair<lcFramebuffer, lcFramebuffer>* RetainedFramebuffer)
+{
+/*** LPub3D Mod end ***/
 	GLint MaxTexture;
 	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &MaxTexture);
 
@@ -853,6 +867,29 @@ bool View::BeginRenderToImage(int Width, int Height)
 	mHeight = TileHeight;
 	mRenderImage = QImage(Width, Height, QImage::Format_ARGB32);
 
+/*** LPub3D Mod - incremental render ***/
+	// A retained framebuffer is owned by the caller and keeps its contents
+	// between renders so the next image can be drawn over the previous one.
+	mRetainedRenderFramebuffer = gSupportsFramebufferObjectARB ? RetainedFramebuffer : nullptr;
+
+	if (mRetainedRenderFramebuffer)
+	{
+		const bool SameSize = mRetainedRenderFramebuffer->first.mWidth == TileWidth && mRetainedRenderFramebuffer->first.mHeight == TileHeight;
+
+		if (!SameSize || !mContext->RestoreRenderFramebuffer(*mRetainedRenderFramebuffer))
+		{
+			// an incremental render needs the previous image
+			if (mIncrementalRender)
+				return false;
+
+			mContext->DestroyRenderFramebuffer(*mRetainedRenderFramebuffer);
+			*mRetainedRenderFramebuffer = mContext->CreateRenderFramebuffer(TileWidth, TileHeight);
+		}
+
+		mRenderFramebuffer = *mRetainedRenderFramebuffer;
+	}
+	else
+/*** LPub3D Mod end ***/
 	mRenderFramebuffer = mContext->CreateRenderFramebuffer(TileWidth, TileHeight);
 	mContext->BindFramebuffer(mRenderFramebuffer.first);
 	return mRenderFramebuffer.first.IsValid();
@@ -861,6 +898,15 @@ bool View::BeginRenderToImage(int Width, int Height)
 void View::EndRenderToImage()
 {
 	mRenderImage = QImage();
+/*** LPub3D Mod - incremental render ***/
+	if (mRetainedRenderFramebuffer)
+	{
+		mContext->ReleaseRenderFramebuffer(*mRetainedRenderFramebuffer);
+		mRenderFramebuffer = std::pair<lcFramebuffer, lcFramebuffer>();
+		mRetainedRenderFramebuffer = nullptr;
+	}
+	else
+/*** LPub3D Mod end ***/
 	mContext->DestroyRenderFramebuffer(mRenderFramebuffer);
 	mContext->ClearFramebuffer();
 }
@@ -925,6 +971,9 @@ void View::OnDraw()
 			mContext->SetDefaultState();
 			mContext->SetViewport(0, 0, mWidth, mHeight);
 
+/*** LPub3D Mod - incremental render ***/
+			if (!mIncrementalRender || !mRetainedRenderFramebuffer || TotalTileRows > 1 || TotalTileColumns > 1)
+/*** LPub3D Mod end ***/
 			mModel->DrawBackground(this);
 
 			int CurrentTileWidth, CurrentTileHeight;
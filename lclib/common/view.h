@@ -163,6 +163,24 @@ public:
 
 	bool BeginRenderToImage(int Width, int Height);
 	void EndRenderToImage();
+/*** LPub3D Mod - incremental render ***/
+	bool BeginRenderToImage(int Width, int Height, std::pair<lcFramebuffer, lcFramebuffer>* RetainedFramebuffer);
+
+	void SetIncrementalRender(bool IncrementalRender)
+	{
+		mIncrementalRender = IncrementalRender;
+	}
+
+	bool IsTiledRender() const
+	{
+		return !mRenderImage.isNull() && (mRenderImage.width() > mWidth || mRenderImage.height() > mHeight);
+	}
+
+	bool HasTranslucentMeshes() const
+	{
+		return mScene.HasTranslucentMeshes();
+	}
+/*** LPub3D Mod end ***/
 
 	QImage GetRenderImage() const
 	{
@@ -211,6 +229,10 @@ protected:
 	PieceInfo* mMouseDownPiece;
 	QImage mRenderImage;
 	std::pair<lcFramebuffer, lcFramebuffer> mRenderFramebuffer;
+/*** LPub3D Mod - incremental render ***/
+	std::pair<lcFramebuffer, lcFramebuffer>* mRetainedRenderFramebuffer;
+	bool mIncrementalRender;
+/*** LPub3D Mod end ***/
 	lcViewSphere mViewSphere;
 
 	lcVertexBuffer mGridBuffer;
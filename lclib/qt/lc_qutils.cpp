@@ -45,6 +45,71 @@ float lcParseValueLocalized(const QString& Value)
 	return QLocale::system().toFloat(Value);
 }
 
+/*** LPub3D Mod - image bounds ***/
+// Returns the bounding box of the non transparent pixels of Image, or an
+// inverted rectangle (left > right) if the image has no opaque content.
+// Rows are scanned in memory order; empty rows are trimmed from the top and
+// bottom first, then each remaining row only scans the columns outside the
+// bounds found so far.
+QRect lcGetImageAlphaBounds(const QImage& Image)
+{
+	const QImage Source = (Image.format() == QImage::Format_ARGB32 || Image.format() == QImage::Format_ARGB32_Premultiplied) ?
+	                      Image : Image.convertToFormat(QImage::Format_ARGB32);
+	const int Width = Source.width();
+	const int Height = Source.height();
+
+	auto RowHasAlpha = [&Source, Width](int y)
+	{
+		const QRgb* Line = reinterpret_cast<const QRgb*>(Source.constScanLine(y));
+		QRgb Mask = 0;
+
+		for (int x = 0; x < Width; x++)
+			Mask |= Line[x];
+
+		return (Mask & 0xff000000) != 0;
+	};
+
+	int MinY = 0;
+	while (MinY < Height && !RowHasAlpha(MinY))
+		MinY++;
+
+	if (MinY == Height)
+		return QRect(QPoint(Width, Height), QPoint(0, 0));
+
+	int MaxY = Height - 1;
+	while (MaxY > MinY && !RowHasAlpha(MaxY))
+		MaxY--;
+
+	int MinX = Width;
+	int MaxX = 0;
+
+	for (int y = MinY; y <= MaxY; y++)
+	{
+		const QRgb* Line = reinterpret_cast<const QRgb*>(Source.constScanLine(y));
+
+		for (int x = 0; x < MinX; x++)
+		{
+			if (qAlpha(Line[x]))
+			{
+				MinX = x;
+				break;
+			}
+		}
+
+		for (int x = Width - 1; x > MaxX; x--)
+		{
+			if (qAlpha(Line[x]))
+			{
+				MaxX = x;
+				break;
+			}
+		}
+	}
+
+	return QRect(QPoint(MinX, MinY), QPoint(MaxX, MaxY));
+}
+/*** LPub3D Mod end ***/
+
 // Resize all columns to content except for one stretching column. (taken from QT creator)
 lcQTreeWidgetColumnStretcher::lcQTreeWidgetColumnStretcher(QTreeWidget *treeWidget, int columnToStretch)
 	: QObject(treeWidget->header()), m_columnToStretch(columnToStretch)
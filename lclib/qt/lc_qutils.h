@@ -5,6 +5,9 @@
 QString lcFormatValue(float Value, int Precision);
 QString lcFormatValueLocalized(float Value);
 float lcParseValueLocalized(const QString& Value);
+/*** LPub3D Mod - image bounds ***/
+QRect lcGetImageAlphaBounds(const QImage& Image);
+/*** LPub3D Mod end ***/
 
 class lcQTreeWidgetColumnStretcher : public QObject
 {
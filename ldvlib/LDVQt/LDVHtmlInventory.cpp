@@ -15,6 +15,7 @@
 #include <QApplication>
 #include <QProgressDialog>
 #include <QMessageBox>
+#include <QtConcurrent>
 
 #include "LDVWidget.h"
 #include "LDVWidgetDefaultKeys.h"
@@ -572,6 +573,88 @@ void LDVHtmlInventory::populateColumnMap(void)
 	}
 }
 
+// Element IDs, lookup site references and part image paths are resolved
+// once per (part, colour) row. The annotation tables are shared, unguarded
+// statics so those lookups stay on this thread; the part image probes into
+// LPub's PLI image cache only touch the file system and are fanned out to
+// the global thread pool. Rows keep the parts list order so the generated
+// HTML is the same on every run.
+void LDVHtmlInventory::resolvePartRows(
+	LDPartsList *partsList,
+	LDVPartListRowVector &rows)
+{
+	const LDPartCountVector &partCounts = partsList->getPartCounts();
+	bool rebrickable = m_partImages &&
+					   m_lookupSite == LookUp::Rebrickable &&
+					   m_modelWidget;
+
+	rows.clear();
+	for (size_t i = 0; i < partCounts.size(); i++)
+	{
+		const LDPartCount &partCount = partCounts[i];
+		const IntVector &colors = partCount.getColors();
+		std::string partName = partCount.getFilename();
+		size_t nDotSpot = partName.find('.');
+		if (nDotSpot < partName.size())
+		{
+			partName = partName.substr(0, nDotSpot);
+		}
+		QString ldPartId = QString::fromStdString(partName);
+		std::string rebrickablePartUrl;
+		if (rebrickable)
+		{
+			rebrickablePartUrl = m_modelWidget->doGetRebrickablePartURL(partName);
+		}
+
+		for (size_t j = 0; j < colors.size(); j++)
+		{
+			LDVPartListRow row;
+			row.partCount = &partCount;
+			row.colorNumber = colors[j];
+			row.partName = partName;
+			row.rebrickableColor = row.colorNumber;
+			row.imageFound = false;
+
+			QString ldColorId(QString::number(row.colorNumber));
+			row.elementId = Annotations::getBLElement(
+				ldColorId, ldPartId, getElementSource());
+
+			if (m_partImages)
+			{
+				row.blElementId = Annotations::getBLElement(
+					ldColorId, ldPartId, ElementSrc::BL);
+				if (m_lookupSite == LookUp::Brickset)
+				{
+					row.legoElementId = Annotations::getBLElement(
+						ldColorId, ldPartId, ElementSrc::LEGO);
+				}
+				if (rebrickable)
+				{
+					row.rebrickableColor = m_modelWidget->doGetRebrickableColor(row.colorNumber);
+					row.rebrickablePartUrl = rebrickablePartUrl;
+				}
+				row.imagePath = QDir::toNativeSeparators(QString("%1/%2_%3_%4.png")
+								.arg(Paths::partsDir)
+								.arg(ldPartId)
+								.arg(ldColorId)
+								.arg(QString::fromStdString(m_partListKey)));
+			}
+
+			rows.push_back(row);
+		}
+	}
+
+	if (m_partImages)
+	{
+		auto LocatePartImage = [](LDVPartListRow &row)
+		{
+			row.imageFound = QFileInfo(row.imagePath).exists();
+		};
+
+		QtConcurrent::blockingMap(rows, LocatePartImage);
+	}
+}
+
 bool LDVHtmlInventory::generateHtml(
 	const char *filename,
 	LDPartsList *partsList,
@@ -611,7 +694,7 @@ bool LDVHtmlInventory::generateHtml(
 		ProgressDialog->show();
 
 		const LDPartCountVector &partCounts = partsList->getPartCounts();
-		int i, j;
+		int i;
 
 		int uniqueParts = int(partCounts.size());
 		int invalidElements = 0;
@@ -619,28 +702,11 @@ bool LDVHtmlInventory::generateHtml(
 
 		QStringList partList;
 
-		IntVector uniqueColors;
 		for (i = 0; i < uniqueParts; i++)
 		{
 			const LDPartCount &partCount = partCounts[i];
-			const IntVector &colors = partCount.getColors();
-			int elements = (int)colors.size();
-			uniqueElements += elements;
 			QString ldPartId(QFileInfo(QString::fromStdString(partCount.getFilename())).completeBaseName());
 			partList.append(ldPartId);
-			for (j = 0; j < elements; j++)
-			{
-				QString ldColorId(QString::number(colors[j]));
-				QString elementId = Annotations::getBLElement(
-					ldColorId, ldPartId,
-					getElementSource());
-				if (elementId.isEmpty()) {
-					invalidElements++;
-					uniqueElements--;
-				}
-				if (find(uniqueColors.begin(), uniqueColors.end(), colors[j]) == uniqueColors.end())
-					uniqueColors.push_back(colors[j]);
-			}
 		}
 
 		if (getLookupSite() == LookUp::Rebrickable &&
@@ -649,34 +715,45 @@ bool LDVHtmlInventory::generateHtml(
 			m_modelWidget->doSetRebrickableParts(partList.join(","));
 		}
 
-		ProgressDialog->setMaximum(uniqueParts);
+		LDVPartListRowVector rows;
+		resolvePartRows(partsList, rows);
+
+		int uniqueRows = int(rows.size());
+
+		IntVector uniqueColors;
+		for (i = 0; i < uniqueRows; i++)
+		{
+			const LDVPartListRow &row = rows[i];
+			if (row.elementId.isEmpty())
+				invalidElements++;
+			else
+				uniqueElements++;
+			if (find(uniqueColors.begin(), uniqueColors.end(), row.colorNumber) == uniqueColors.end())
+				uniqueColors.push_back(row.colorNumber);
+		}
+
+		ProgressDialog->setMaximum(uniqueRows);
 
 		writeHeader(file);
 		writeTableHeader(file, partsList->getTotalParts(), invalidElements,
 						 uniqueElements, uniqueParts, uniqueColors.size());
-		for (i = 0; i < uniqueParts; i++)
+		for (i = 0; i < uniqueRows; i++)
 		{
 			ProgressDialog->setValue(i);
 			QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
 
-			const LDPartCount &partCount = partCounts[i];
-			const IntVector &colors = partCount.getColors();
-			LDLModel *model = const_cast<LDLModel *>(partCount.getModel());
+			const LDVPartListRow &row = rows[i];
+			LDLModel *model = const_cast<LDLModel *>(row.partCount->getModel());
 			LDLPalette *palette = model->getMainModel()->getPalette();
+			LDLColorInfo colorInfo = palette->getAnyColorInfo(row.colorNumber);
 
-			for (j = 0; j < (int)colors.size(); j++)
-			{
-				int colorNumber = colors[j];
-				LDLColorInfo colorInfo = palette->getAnyColorInfo(colorNumber);
-
-				writePartRow(file, partCount, palette, colorInfo, colorNumber);
-			}
+			writePartRow(file, row, palette, colorInfo);
 		}
 		writeTableFooter(file);
 		writeFooter(file);
 		fclose(file);
 
-		ProgressDialog->setValue(uniqueParts);
+		ProgressDialog->setValue(uniqueRows);
 		ProgressDialog->hide();
 		QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
 		ProgressDialog->deleteLater();
@@ -1076,26 +1153,15 @@ void LDVHtmlInventory::writeHeaderCell(FILE *file, LDVPartListColumn column)
 
 void LDVHtmlInventory::writePartCell(
 	FILE *file,
-	const LDPartCount &partCount,
-	LDLPalette *palette,
-	const LDLColorInfo &colorInfo,
-	int colorNumber)
+	const LDVPartListRow &row)
 {
 	std::string className;
-	std::string partName = partCount.getFilename();
+	const LDPartCount &partCount = *row.partCount;
+	std::string partName = row.partName;
 	std::string style = "";
 
-	int r, g, b, a;
 	bool element = true;
 
-	palette->getRGBA(colorInfo, r, g, b, a);
-
-	size_t nDotSpot = partName.find('.');
-	if (nDotSpot < partName.size())
-	{
-		partName = partName.substr(0, nDotSpot);
-	}
-
 	if (m_partImages)
 	{
 
@@ -1106,10 +1172,7 @@ void LDVHtmlInventory::writePartCell(
 
 		std::string viewOnString = "";
 
-		QString elementId = Annotations::getBLElement(
-					QString::number(colorNumber),
-					QString::fromStdString(partName),
-					ElementSrc::BL);
+		QString elementId = row.blElementId;
 
 		element = !elementId.isEmpty();
 
@@ -1139,10 +1202,7 @@ void LDVHtmlInventory::writePartCell(
 			break;
 		case LookUp::Brickset:
 		{
-			elementId = Annotations::getBLElement(
-								QString::number(colorNumber),
-								QString::fromStdString(partName),
-								ElementSrc::LEGO);
+			elementId = row.legoElementId;
 
 			fprintf(file, "			<td%s>"
 						  "<a href=\"https://brickset.com/parts/%s/\">",
@@ -1154,15 +1214,11 @@ void LDVHtmlInventory::writePartCell(
 			break;
 		case LookUp::Rebrickable:
 		{
-			int rebricableColor = m_modelWidget->doGetRebrickableColor(colorNumber);
-
-			std::string rebricablePartUrl = m_modelWidget->doGetRebrickablePartURL(partName);
-
 			fprintf(file, "			<td%s>"
 						  "<a href=\"%s%d/\">",
 					className.c_str(),
-					rebricablePartUrl.c_str(),
-					rebricableColor);
+					row.rebrickablePartUrl.c_str(),
+					row.rebrickableColor);
 
 			viewOnString = lsUtf8(element ? "PLViewOnRebrickable" : "PLVInvalidElement");
 		}
@@ -1193,13 +1249,9 @@ void LDVHtmlInventory::writePartCell(
 			 titleString = lsUtf8("PLNoDescription");
 		titleString.append(" - " + viewOnString);
 
-		QString localPartPath = QDir::toNativeSeparators(QString("%1/%2_%3_%4.png")
-								.arg(Paths::partsDir)
-								.arg(QString::fromStdString(partName))
-								.arg(QString::number(colorNumber))
-								.arg(QString::fromStdString(m_partListKey)));
-								
-		if (!QFileInfo(localPartPath).exists()) {
+		QString localPartPath = row.imagePath;
+
+		if (!row.imageFound) {
 			localPartPath = QString(VER_LPUB3D_IMAGE_NOT_FOUND_URL);
 			titleString = lsUtf8("PLVImageNotFound") + titleString;
 		}
@@ -1276,22 +1328,11 @@ void LDVHtmlInventory::writeColorCell(
 
 void LDVHtmlInventory::writeElementCell(
 	FILE *file,
-	const LDPartCount &partCount,
-	int colorNumber)
+	const LDVPartListRow &row)
 {
-	bool bl = m_lookupSite == LookUp::Bricklink;
-	std::string partName = partCount.getFilename();
 	std::string style = "";
-	size_t nDotSpot = partName.find('.');
-	if (nDotSpot < partName.size())
-	{
-		partName = partName.substr(0, nDotSpot);
-	}
 
-	QString elementId = Annotations::getBLElement(
-		QString::number(colorNumber),
-		QString::fromStdString(partName),
-		getElementSource());
+	QString elementId = row.elementId;
 
 	if (elementId.isEmpty())
 	{
@@ -1314,27 +1355,26 @@ void LDVHtmlInventory::writeQuantityCell(
 
 void LDVHtmlInventory::writeCell(
 	FILE *file, LDVPartListColumn column,
-	const LDPartCount &partCount,
+	const LDVPartListRow &row,
 	LDLPalette *palette,
-	const LDLColorInfo &colorInfo,
-	int colorNumber)
+	const LDLColorInfo &colorInfo)
 {
 	switch (column)
 	{
 	case LDVPLCPart:
-		writePartCell(file, partCount, palette, colorInfo, colorNumber);
+		writePartCell(file, row);
 		break;
 	case LDVPLCDescription:
-		writeDescriptionCell(file, partCount);
+		writeDescriptionCell(file, *row.partCount);
 		break;
 	case LDVPLCColor:
-		writeColorCell(file, palette, colorInfo, colorNumber);
+		writeColorCell(file, palette, colorInfo, row.colorNumber);
 		break;
 	case LDVPLCElement:
-		writeElementCell(file, partCount, colorNumber);
+		writeElementCell(file, row);
 		break;
 	case LDVPLCQuantity:
-		writeQuantityCell(file, partCount, colorNumber);
+		writeQuantityCell(file, *row.partCount, row.colorNumber);
 		break;
 	}
 }
@@ -1504,18 +1544,16 @@ void LDVHtmlInventory::writeTableFooter(FILE *file)
 
 void LDVHtmlInventory::writePartRow(
 	FILE *file,
-	const LDPartCount &partCount,
+	const LDVPartListRow &row,
 	LDLPalette *palette,
-	const LDLColorInfo &colorInfo,
-	int colorNumber)
+	const LDLColorInfo &colorInfo)
 {
 	size_t i;
 
 	fprintf(file, "		<tr>\n");
 	for (i = 0; i < m_columnOrder.size(); i++)
 	{
-		writeCell(file, m_columnOrder[i], partCount, palette, colorInfo,
-			colorNumber);
+		writeCell(file, m_columnOrder[i], row, palette, colorInfo);
 	}
 	fprintf(file, "		</tr>\n");
 }
@@ -6,6 +6,8 @@
 #include <LDLoader/LDLPalette.h>
 #include <stdio.h>
 
+#include <QString>
+
 class LDPartsList;
 class LDPartCount;
 class LDLPalette;
@@ -28,6 +30,24 @@ typedef enum
 typedef std::vector<LDVPartListColumn> LDVPartListColumnVector;
 typedef std::map<LDVPartListColumn, bool> LDVPartListColumnBoolMap;
 
+// A part list row with its element, lookup site and image references
+// resolved once before the HTML is written
+struct LDVPartListRow
+{
+	const LDPartCount *partCount;
+	int colorNumber;
+	std::string partName;
+	QString elementId;
+	QString blElementId;
+	QString legoElementId;
+	int rebrickableColor;
+	std::string rebrickablePartUrl;
+	QString imagePath;
+	bool imageFound;
+};
+
+typedef std::vector<LDVPartListRow> LDVPartListRowVector;
+
 class LDVHtmlInventory : public TCObject
 {
 
@@ -104,25 +124,24 @@ protected:
 						  int invalidElements, int uniqueElements,
 						  int uniqueParts, int uniqueColors);
 	void writeTableFooter(FILE *file);
-	void writePartRow(FILE *file, const LDPartCount &partCount,
-		LDLPalette *palette, const LDLColorInfo &colorInfo, int colorNumber);
+	void writePartRow(FILE *file, const LDVPartListRow &row,
+		LDLPalette *palette, const LDLColorInfo &colorInfo);
 	bool writeExternalCss(void);
 	FILE *safeOpenCssFile(const std::string &cssFilename, bool &match);
 	void writePartHeaderCell(FILE *file);
 	void writeHeaderCell(FILE *file, LDVPartListColumn column, int colSpan);
 	void writeHeaderCell(FILE *file, LDVPartListColumn column);
-	void writePartCell(FILE *file, const LDPartCount &partCount,
-		LDLPalette *palette, const LDLColorInfo &colorInfo, int colorNumber);
+	void writePartCell(FILE *file, const LDVPartListRow &row);
 	void writeDescriptionCell(FILE *file, const LDPartCount &partCount);
 	void writeColorCell(FILE *file, LDLPalette *palette,
 		const LDLColorInfo &colorInfo, int colorNumber);
-	void writeElementCell(FILE *file, const LDPartCount &partCount,
-		int colorNumber);
+	void writeElementCell(FILE *file, const LDVPartListRow &row);
 	void writeQuantityCell(FILE *file, const LDPartCount &partCount,
 		int colorNumber);
 	void writeCell(FILE *file, LDVPartListColumn column,
-		const LDPartCount &partCount, LDLPalette *palette,
-		const LDLColorInfo &colorInfo, int colorNumber);
+		const LDVPartListRow &row, LDLPalette *palette,
+		const LDLColorInfo &colorInfo);
+	void resolvePartRows(LDPartsList *partsList, LDVPartListRowVector &rows);
 	void populateColumnMap(void);
 	std::string getSnapshotFilename(void) const;
 
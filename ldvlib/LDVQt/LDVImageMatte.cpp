@@ -267,68 +267,45 @@ bool LDVImageMatte::matteCSIImages(QString csiKey, QString &baseImagePath, QStri
   logType = overlayImage.height() != baseImage.height() ? LOG_INFO : LOG_STATUS;
   emit lpubAlert->messageSig(logType,imageHeightMsg);
 
-  // draw the overlay image on top of the base image
-//  baseImage.drawImage(0,0, overlayImage);
+  // draw the overlay image pixel on top of the base image pixel,
+  // tracking the opaque bounds in the same pass
+  int MinX = baseImage.width();
+  int MinY = baseImage.height();
+  int MaxX = 0;
+  int MaxY = 0;
+
+  const int overlayWidth  = qMin(baseImage.width(), overlayImage.width());
+  const int overlayHeight = qMin(baseImage.height(), overlayImage.height());
 
-  // draw the overlay image pixel on top of the base image pixel
   for(int y = 0; y < baseImage.height(); ++y)
     {
       for(int x = 0; x < baseImage.width(); ++x)
         {
-          baseImage.drawPixel(x, y, overlayImage.get16(x, y));
+          if (x < overlayWidth && y < overlayHeight)
+            baseImage.drawPixel(x, y, overlayImage.get16(x, y));
+          if (baseImage.get16(x, y).a)  // .a = 0
+            {
+              MinX = qMin(x, MinX);
+              MinY = qMin(y, MinY);
+              MaxX = qMax(x, MaxX);
+              MaxY = qMax(y, MaxY);
+            }
         }
     }
 
-  struct ClippedImage
-  {
-    WPngImage Image;
-    QString Path;
-    QRect Bounds;
-    QString BoundMsg;
-  };
-
-  ClippedImage clippedImage;
-  auto CalculateImageBounds = [](ClippedImage& _Image)
-  {
-    WPngImage& Image = _Image.Image;
-
-    int MinX = Image.width();
-    int MinY = Image.height();
-    int MaxX = 0;
-    int MaxY = 0;
-
-    for(int y = 0; y < Image.height(); ++y)
-      {
-        for(int x = 0; x < Image.width(); ++x)
-          {
-            //qDebug() << QString("Image.get16(x[%1], y[%2]).a[%3]").arg(x).arg(y).arg(Image.get16(x, y).a);
-            if (Image.get16(x, y).a)  // .a = 0
-              {
-                MinX = qMin(x, MinX);
-                MinY = qMin(y, MinY);
-                MaxX = qMax(x, MaxX);
-                MaxY = qMax(y, MaxY);
-              }
-          }
-      }
-
-    _Image.Bounds = QRect(QPoint(MinX, MinY), QPoint(MaxX, MaxY));
-    _Image.Image.resizeCanvas(_Image.Bounds.x(),_Image.Bounds.y(),_Image.Bounds.width(), _Image.Bounds.height());
-    _Image.BoundMsg = QString("Matte Image %1 clipped to Width %2 x Height %3")
-                              .arg(QFileInfo(_Image.Path).fileName())
-                              .arg(_Image.Image.width())
-                              .arg(_Image.Image.height());
-  };
-
-  clippedImage.Image    = baseImage;
-  clippedImage.Path     = getMatteCSIImage(csiKey);
-  CalculateImageBounds(clippedImage);
+  // clip the blended image in place and write it once
+  const QString clippedImagePath = getMatteCSIImage(csiKey);
+  const QRect Bounds(QPoint(MinX, MinY), QPoint(MaxX, MaxY));
+  baseImage.resizeCanvas(Bounds.x(), Bounds.y(), Bounds.width(), Bounds.height());
 
-  const auto clippedImageStatus = clippedImage.Image.saveImage(clippedImage.Path.toUtf8().constData());
+  const auto clippedImageStatus = baseImage.saveImage(clippedImagePath.toUtf8().constData());
   if (clippedImageStatus.printErrorMsg()) {
       return false;
     } else {
-      emit lpubAlert->messageSig(LOG_INFO, clippedImage.BoundMsg);
+      emit lpubAlert->messageSig(LOG_INFO, QString("Matte Image %1 clipped to Width %2 x Height %3")
+                                                   .arg(QFileInfo(clippedImagePath).fileName())
+                                                   .arg(baseImage.width())
+                                                   .arg(baseImage.height()));
     }
 
   return true;
@@ -4,6 +4,7 @@ QT      += opengl
 QT      += network
 QT      += widgets
 QT      += gui
+QT      += concurrent
 CONFIG  += thread
 CONFIG  += staticlib
 CONFIG  += warn_on
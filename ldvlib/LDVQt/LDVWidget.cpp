@@ -523,6 +523,39 @@ bool LDVWidget::grabImage(
 	return ok;
 }
 
+/*
+ * Grab the snapshot taker's frame buffer and hand it to callback as an
+ * in-memory image, so callers can matte, clip or cache the snapshot and
+ * write it once, instead of reading back a PNG written by the snapshot taker.
+ * Only available when rendering to a frame buffer object.
+ */
+bool LDVWidget::grabImage(
+	int imageWidth,
+	int imageHeight,
+	const SnapshotCallback &callback)
+{
+	if (!snapshotTaker || !snapshotTaker->getUseFBO())
+		return false;
+
+	makeCurrent();
+	modelViewer->setMemoryUsage(0);
+
+	bool saveAlpha = false;
+	TCByte *buffer = snapshotTaker->grabImage(imageWidth, imageHeight,
+		saveImageZoomToFit, nullptr, &saveAlpha);
+	if (!buffer)
+		return false;
+
+	// rows are bottom-up and 4-byte aligned, as read back from OpenGL
+	int bytesPerPixel = saveAlpha ? 4 : 3;
+	int bytesPerLine = (imageWidth * bytesPerPixel + 3) & ~3;
+	QImage image(buffer, imageWidth, imageHeight, bytesPerLine,
+		saveAlpha ? QImage::Format_RGBA8888 : QImage::Format_RGB888);
+	bool ok = callback(image.mirrored());
+	delete[] buffer;
+	return ok;
+}
+
 bool LDVWidget::saveImage(
 	char *filename,
 	int imageWidth,
@@ -542,11 +575,27 @@ bool LDVWidget::saveImage(
 	snapshotTaker->setImageType(LDSnapshotTaker::ITPng);
 	snapshotTaker->setTrySaveAlpha(
 		TCUserDefaults::longForKey(SAVE_ALPHA_KEY, 0, false));
-	snapshotTaker->setAutoCrop(
-		TCUserDefaults::boolForKey(AUTO_CROP_KEY, false, false));
+	bool autoCrop = TCUserDefaults::boolForKey(AUTO_CROP_KEY, false, false);
+	snapshotTaker->setAutoCrop(autoCrop);
 	saveImageFilename = filename;
 	saveImageZoomToFit = TCUserDefaults::longForKey(SAVE_ZOOM_TO_FIT_KEY, 1,
 		false);
+	if (snapshotTaker->getUseFBO() && !autoCrop)
+	{
+		// write the grabbed buffer once, skipping the snapshot taker's own PNG pass
+		QString snapshot = QString::fromUtf8(filename);
+		retValue = grabImage(imageWidth, imageHeight, [&snapshot](const QImage &image)
+		{
+			QImageWriter Writer(snapshot, "PNG");
+			if (!Writer.write(image)) {
+				emit lpubAlert->messageSig(LOG_ERROR, QString("Error writing to file '%1':\n%2").arg(snapshot).arg(Writer.errorString()));
+				return false;
+			}
+			return true;
+		});
+		if (retValue)
+			return retValue;
+	}
 	retValue = grabImage(imageWidth, imageHeight);
 	return retValue;
 }
@@ -994,51 +1043,54 @@ int LDVWidget::doGetRebrickableColor(const int LDrawColorID) const
 
 std::string LDVWidget::doGetRebrickablePartURL(const std::string &LDrawPartID, bool alt) const
 {
+	QHash<QString, std::string>::const_iterator it =
+			m_RebrickablePartURLs.constFind(QString::fromStdString(LDrawPartID));
+	if (it != m_RebrickablePartURLs.constEnd())
+		return it.value();
+
+	// final check - if we get here, check cross-reference
+	std::string altPart = Annotations::getRBPartID(QString::fromStdString(LDrawPartID)).toStdString();
+	if (!alt && !altPart.empty())
+		return doGetRebrickablePartURL(altPart, true);
+
+	return std::string("");
+}
+
+// Index the downloaded Rebrickable parts once so each part list row is a
+// hash lookup rather than a parse and scan of the whole JSON reply.
+// The Rebrickable part code is inserted before the part's LDraw external
+// IDs and earlier parts win, which keeps the original scan order.
+void LDVWidget::indexRebrickableParts()
+{
+	m_RebrickablePartURLs.clear();
+
 	QJsonDocument Document = QJsonDocument::fromJson(m_RebrickableParts);
 	QJsonObject Root = Document.object();
 	QJsonArray Parts = Root["results"].toArray();
-	// Converting QByteArray to QString Utf8 constData
-	// because QByteArray.toStdString() is only available
-	//if Qt is configured with STL compatibility enabled.
-	std::string utf8String;
 	for (const QJsonValue& Part : Parts)
 	{
-		// primary check
+		// Converting QByteArray to QString Utf8 constData
+		// because QByteArray.toStdString() is only available
+		//if Qt is configured with STL compatibility enabled.
 		QJsonObject PartObject = Part.toObject();
 		QByteArray RBPartUrl = PartObject["part_url"].toString().toLatin1();
-		QByteArray RBPartCode = PartObject["part_num"].toString().toLatin1();
-		utf8String = QString(RBPartCode).toUtf8().constData();
-		if (LDrawPartID == utf8String) {
-			emit lpubAlert->messageSig(LOG_INFO, QString("LDID=%1 RBCode=%2 RBUrl=%3 ")
-									   .arg(QString::fromStdString(LDrawPartID))
-									   .arg(QString(RBPartCode))
-									   .arg(QString(RBPartUrl)));
-			utf8String = QString(RBPartUrl).toUtf8().constData();
-			return utf8String;
-		}
-		// secondary check
+		std::string utf8Url = QString(RBPartUrl).toUtf8().constData();
+		// primary key
+		QString RBPartCode = PartObject["part_num"].toString();
+		if (!m_RebrickablePartURLs.contains(RBPartCode))
+			m_RebrickablePartURLs.insert(RBPartCode, utf8Url);
+		// secondary keys
 		QJsonArray PartIDArray = PartObject["external_ids"].toObject()["LDraw"].toArray();
-		if (!PartIDArray.isEmpty()) {
-			for (int i = 0; i < PartIDArray.size(); i++){
-				QByteArray LDPartCode = PartIDArray[i].toString().toLatin1();
-				utf8String = QString(LDPartCode).toUtf8().constData();
-				if (LDrawPartID == utf8String) {
-					emit lpubAlert->messageSig(LOG_INFO, QString("LDCode=%1 RBCode=%2 RBUrl=%3 ")
-											   .arg(QString(LDPartCode))
-											   .arg(QString(RBPartCode))
-											   .arg(QString(RBPartUrl)));
-					std::string utf8String = QString(RBPartUrl).toUtf8().constData();
-					return utf8String;
-				}
-			}
+		for (int i = 0; i < PartIDArray.size(); i++){
+			QString LDPartCode = PartIDArray[i].toString();
+			if (!m_RebrickablePartURLs.contains(LDPartCode))
+				m_RebrickablePartURLs.insert(LDPartCode, utf8Url);
 		}
 	}
-	// final check - if we get here, check cross-reference
-	std::string altPart = Annotations::getRBPartID(QString::fromStdString(LDrawPartID)).toStdString();
-	if (!alt && !altPart.empty())
-		doGetRebrickablePartURL(altPart, true);
 
-	return std::string("");
+	emit lpubAlert->messageSig(LOG_INFO, QString("Indexed %1 Rebrickable part URLs from %2 parts.")
+							   .arg(m_RebrickablePartURLs.size())
+							   .arg(Parts.size()));
 }
 
 void LDVWidget::DownloadFinished(lcHttpReply* Reply)
@@ -1071,9 +1123,10 @@ void LDVWidget::DownloadFinished(lcHttpReply* Reply)
 	}
 	else if (Reply == m_PartsReply)
 	{
-		if (!Reply->error())
+		if (!Reply->error()) {
 			m_RebrickableParts = Reply->readAll();
-		else
+			indexRebrickableParts();
+		} else
 			emit lpubAlert->messageSig(LOG_ERROR, QString("%1").arg("Could not download Rebrickable parts."));
 
 		m_PartsReply = nullptr;
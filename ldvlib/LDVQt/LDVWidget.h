@@ -32,6 +32,7 @@
 
 #include <QProgressDialog>
 #include <QTimer>
+#include <functional>
 #include "name.h"
 
 #include "LDVHtmlInventory.h"
@@ -80,8 +81,10 @@ public:
 	void doPartList(void);
 	void doPartList(LDVHtmlInventory *htmlInventory, LDPartsList *partsList,
 					const char *filename);
+	typedef std::function<bool(const QImage &)> SnapshotCallback;
 	bool saveImage(char *filename, int imageWidth, int imageHeight);
 	bool grabImage(int &imageWidth, int &imageHeight);
+	bool grabImage(int imageWidth, int imageHeight, const SnapshotCallback &callback);
 	void setViewMode(LDInputHandler::ViewMode value, bool examineLatLong,
 					 bool keepRightSideUp, bool saveSettings=true);
 	void showDocument(QString &htmlFilename);
@@ -104,6 +107,7 @@ protected:
 	bool getUseFBO(void);
 	bool loadModel(const char *filename);
 	void setupSnapshotBackBuffer(int width, int height);
+	void indexRebrickableParts(void);
 
 	IniFlag                iniFlag;
 	bool                   forceIni;
@@ -137,6 +141,7 @@ protected:
 	lcHttpReply* m_PartsReply;
 	QStringList m_Keys;
 	QByteArray m_RebrickableParts;
+	QHash<QString, std::string> m_RebrickablePartURLs;
 
 };
 
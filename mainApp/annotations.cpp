@@ -20,6 +20,7 @@
 #include <QTextStream>
 #include <QCheckBox>
 #include "lpub_preferences.h"
+#include "partattributes.h"
 #include "messageboxresizable.h"
 #include "name.h"
 #include "version.h"
@@ -1328,6 +1329,7 @@ Annotations::Annotations()
     }
 
     if (annotationStyles.size() == 0) {
+        PartAttributes::clear();
         QString styleFile = Preferences::annotationStyleFile;
         QRegExp rx("^(\\b[^=]+\\b)=([1|2|3])\\s+([1-6])?\\s*(\".*\"|[^\\s]+).*$");
         if (!styleFile.isEmpty()) {
@@ -545,6 +545,8 @@ void Application::initialize()
                 fprintf(stdout, "  +lv, ++libvexiq: Load the LDraw VEXIQ archive parts library in GUI mode.\n");
                 fprintf(stdout, "  -sl --stud-logo <type>: Set the stud logo type 0 - 5, default is 0 no logo.\n");
                 fprintf(stdout, "  -d, --image-output-directory <directory>: Designate the png, jpg or bmp save folder using absolute path.\n");
+                fprintf(stdout, "  -ew, --export-workers <number>: Split the pdf export page range across this many worker processes and merge their page images. Default is 0, no workers.\n");
+                fprintf(stdout, "  -rw, --render-workers <number>: Render Native part and submodel images on this many worker processes. Step images are rendered in process. A worker that crashes or times out is restarted and its image retried. Default is 0, render in process.\n");
                 fprintf(stdout, "  -fc, --fade-steps-color <LDraw color code>: Set the global fade color. Overridden by fade opacity - if opacity not 100 percent. Default is %s\n",LEGO_FADE_COLOUR_DEFAULT);
                 fprintf(stdout, "  -fo, --fade-step-opacity <percent>: Set the fade steps opacity percent. Overrides fade color - if opacity not 100 percent. Default is %s percent\n",QString(FADE_OPACITY_DEFAULT).toLatin1().constData());
                 fprintf(stdout, "  -fs, --fade-steps: Turn on fade previous steps. Default is off.\n");
@@ -42,6 +42,10 @@
 
 #include "lpubalert.h"
 #include "name.h"
+#include "resolution.h"
+
+// cost is in KB - allow roughly 64 MB of rendered page backgrounds
+QCache<QString, QPixmap> BackgroundItem::pageBackgroundCache(64 * 1024);
 
 void BackgroundItem::setBackground(
     QPixmap         *pixmap,
@@ -93,6 +97,20 @@ void BackgroundItem::setBackground(
         }
     }
 
+  // Reuse a previously rendered page background when nothing differs
+  QString pageBackground;
+  if (_parentRelativeType == PageType) {
+      pageBackground = pageBackgroundKey(pixmap, _exporting);
+      QPixmap *cached = pageBackgroundCache.object(pageBackground);
+      if (cached) {
+          *pixmap = *cached;
+          setToolTip(toolTip);
+          setFlag(QGraphicsItem::ItemIsSelectable,true);
+          setFlag(QGraphicsItem::ItemIsMovable,true);
+          return;
+      }
+  }
+
   int bt = int(borderData.thickness);
 
   QColor penColor,brushColor;
@@ -250,11 +268,40 @@ void BackgroundItem::setBackground(
 
   painter.end();
 
+  if (! pageBackground.isEmpty()) {
+      int cost = qMax(1, pixmap->width() * pixmap->height() * pixmap->depth() / 8 / 1024);
+      pageBackgroundCache.insert(pageBackground, new QPixmap(*pixmap), cost);
+  }
+
   setToolTip(toolTip);
   setFlag(QGraphicsItem::ItemIsSelectable,true);
   setFlag(QGraphicsItem::ItemIsMovable,true);
 }
 
+QString BackgroundItem::pageBackgroundKey(const QPixmap *pixmap, bool exporting)
+{
+  BackgroundData backgroundData = background.value();
+
+  QString key = QString("%1x%2|%3|%4|%5|%6")
+                        .arg(pixmap->width())
+                        .arg(pixmap->height())
+                        .arg(double(resolution()))
+                        .arg(background.format(false,false))
+                        .arg(border.format(false,false))
+                        .arg(exporting);
+
+  if (backgroundData.type == BackgroundData::BgSubmodelColor)
+      key += QString("|%1").arg(subModelColor.value(submodelLevel));
+
+  if (backgroundData.type == BackgroundData::BgImage)
+      key += QString("|%1").arg(QFileInfo(backgroundData.string).lastModified().toMSecsSinceEpoch());
+
+  if (Preferences::snapToGrid && ! Preferences::hidePageBackground && ! exporting)
+      key += QString("|%1|%2").arg(Preferences::sceneGridColor).arg(Preferences::gridSizeIndex);
+
+  return key;
+}
+
 int BackgroundItem::pageSizeP(int which){
  int _size;
 
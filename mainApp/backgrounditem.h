@@ -43,6 +43,7 @@
 #define BACKGROUND_H
 
 #include <QObject>
+#include <QCache>
 #include <QGraphicsPixmapItem>
 #include "metaitem.h"
 
@@ -73,8 +74,18 @@ public:
 
   int pageSizeP(int which);
 
+  static void clearPageBackgroundCache()
+  {
+    pageBackgroundCache.clear();
+  }
+
 private: 
   QGradient setGradient();
+  QString pageBackgroundKey(const QPixmap *pixmap, bool exporting);
+
+  // rendered page backgrounds are identical across pages that share the
+  // same background, border and size so they are painted once and shared
+  static QCache<QString, QPixmap> pageBackgroundCache;
 };
 
 class PlacementBackgroundItem : public BackgroundItem   
@@ -16,7 +16,9 @@
 
 #include "application.h"
 #include "lc_profile.h"
+#include "paths.h"
 #include "lpub.h"
+#include "renderworkers.h"
 
 int Gui::processCommandLine()
 {
@@ -42,6 +44,7 @@ int Gui::processCommandLine()
   bool useLDVSingleCall      = false;
   bool useLDVSnapShotList    = false;
   bool useNativeRenderer     = false;
+  bool renderWorker          = false;
   QString generator          = RENDERER_NATIVE;
 
   QString pageRange, exportOption,
@@ -176,6 +179,28 @@ int Gui::processCommandLine()
       if (Param == QLatin1String("-r") || Param == QLatin1String("--range"))
         ParseString(pageRange, true);
       else
+      if (Param == QLatin1String("-ew") || Param == QLatin1String("--export-workers"))
+        ParseInteger(exportWorkers);
+      else
+      if (Param == QLatin1String("-rw") || Param == QLatin1String("--render-workers"))
+        ParseInteger(renderWorkers);
+      else
+      if (Param == QLatin1String("--render-worker"))
+        renderWorker = true;
+      else
+      if (Param == QLatin1String("--export-shard"))
+      {
+        // pdf export worker - keep temp files and image caches apart from
+        // the other workers, which would render the same images concurrently.
+        // The shard caches are kept between exports and removed with the
+        // main process' caches.
+        QString shard;
+        ParseString(shard, true);
+        Paths::tmpDir      = QString("%1/shard_%2").arg(Paths::tmpDir).arg(shard);
+        Paths::assemDir    = QString("%1/shard_%2").arg(Paths::assemDir).arg(shard);
+        Paths::partsDir    = QString("%1/shard_%2").arg(Paths::partsDir).arg(shard);
+        Paths::submodelDir = QString("%1/shard_%2").arg(Paths::submodelDir).arg(shard);
+      } else
       if (Param == QLatin1String("--line-width"))
         ParseInteger(highlightLineWidth);
       else
@@ -394,6 +419,10 @@ int Gui::processCommandLine()
       partWorkerLDSearchDirs.resetSearchDirSettings();
     }
 
+  // Native render worker - render the jobs sent by the main process
+  if (renderWorker)
+      return RenderWorkers::exec();
+
   QElapsedTimer commandTimer;
   if (!commandlineFile.isEmpty()) {
       if(resetCache) {
@@ -406,6 +435,9 @@ int Gui::processCommandLine()
       }
   }
 
+  if (renderWorkers > 0 && Preferences::preferredRenderer == RENDERER_NATIVE)
+      RenderWorkers::start(renderWorkers, Arguments.mid(1));
+
   if (processPageRange(pageRange)) {
       if (processFile){
           Preferences::pageDisplayPause = 1;
@@ -443,8 +475,12 @@ int Gui::processCommandLine()
           } else {
             continuousPageDialog(PAGE_NEXT);
           }
-    } else
-    return 1;
+    } else {
+      RenderWorkers::stop();
+      return 1;
+    }
+
+  RenderWorkers::stop();
 
   emit messageSig(LOG_INFO,QString("Model file '%1' processed. %2.")
                           .arg(QFileInfo(commandlineFile).fileName())
@@ -51,6 +51,7 @@
 #include "pagepointer.h"
 #include "lgraphicsscene.h"
 #include "name.h"
+#include "pageimagecache.h"
 
 #include "ranges_item.h"
 #include "csiannotation.h"
@@ -66,6 +67,28 @@
  * delete all the GraphicsItems and do a freeranges.h.
  */
 
+/*
+ * Collect the CSI image of the step and its callout steps so the
+ * page images can be decoded in the background before they are placed.
+ */
+static void collectStepImages(Step *step, QStringList &images)
+{
+  images << step->pngName;
+  for (int k = 0; k < step->list.size(); k++) {
+      if (step->list[k]->relativeType == CalloutType) {
+          Callout *callout = dynamic_cast<Callout *>(step->list[k]);
+          for (int l = 0; l < callout->list.size(); l++) {
+              Range *range = dynamic_cast<Range *>(callout->list[l]);
+              for (int m = 0; m < range->list.size(); m++) {
+                  Step *calloutStep = dynamic_cast<Step *>(range->list[m]);
+                  if (calloutStep && calloutStep->relativeType == StepType)
+                      collectStepImages(calloutStep, images);
+              }
+          }
+      }
+  }
+}
+
 void Gui::clearPage(
     LGraphicsView *view,
     LGraphicsScene *scene,
@@ -933,6 +956,19 @@ int Gui::addGraphicsPageItems(
       // qDebug() << "List relative type: " << RelNames[range->relativeType];
       // We've got a page that contains step groups, so add it
       if (page->list.size()) {
+          // LDView single call - decode the step group images in the background
+          if (renderer->useLDViewSCall()) {
+              QStringList images;
+              for (int i = 0; i < page->list.size(); i++){
+                  Range *range = dynamic_cast<Range *>(page->list[i]);
+                  for (int j = 0; j < range->list.size(); j++){
+                      Step *step = dynamic_cast<Step *>(range->list[j]);
+                      if (step && step->relativeType == StepType)
+                          collectStepImages(step, images);
+                  }
+              }
+              PageImageCache::prefetch(images);
+          }
           for (int i = 0; i < page->list.size(); i++){
               Range *range = dynamic_cast<Range *>(page->list[i]);
               for (int j = 0; j < range->list.size(); j++){
@@ -1107,7 +1143,7 @@ int Gui::addGraphicsPageItems(
  */
 int Gui::addStepImageGraphics(Step *step) {
   int retVal = 0;
-  step->csiPixmap.load(step->pngName);
+  step->csiPixmap = PageImageCache::pixmap(step->pngName);
   step->csiPlacement.size[0] = step->csiPixmap.width();
   step->csiPlacement.size[1] = step->csiPixmap.height();
   step->viewerOptions->ImageWidth = step->csiPixmap.width();
@@ -2535,7 +2571,7 @@ int Gui::addCoverPageAttributes(
           fileInfo.setFile(getFilePath(page->meta.LPub.page.documentLogoFront.file.value()));
           if (fileInfo.exists()) {
               QPixmap qpixmap;
-              qpixmap.load(fileInfo.absoluteFilePath());
+              PageAttributePixmapItem::loadPixmap(fileInfo.absoluteFilePath(),qpixmap);
               pixmapLogoFront
                       = new PageAttributePixmapItem(
                           page,
@@ -2573,7 +2609,7 @@ int Gui::addCoverPageAttributes(
           fileInfo.setFile(getFilePath(page->meta.LPub.page.coverImage.file.value()));
           if (fileInfo.exists()) {
               QPixmap qpixmap;
-              qpixmap.load(fileInfo.absoluteFilePath());
+              PageAttributePixmapItem::loadPixmap(fileInfo.absoluteFilePath(),qpixmap);
               pixmapCoverImageFront
                       = new PageAttributePixmapItem(
                           page,
@@ -2837,7 +2873,7 @@ int Gui::addCoverPageAttributes(
           fileInfo.setFile(getFilePath(page->meta.LPub.page.documentLogoBack.file.value()));
           if (fileInfo.exists()) {
               QPixmap qpixmap;
-              qpixmap.load(fileInfo.absoluteFilePath());
+              PageAttributePixmapItem::loadPixmap(fileInfo.absoluteFilePath(),qpixmap);
               pixmapLogoBack =
                       new PageAttributePixmapItem(
                           page,
@@ -2875,7 +2911,7 @@ int Gui::addCoverPageAttributes(
           fileInfo.setFile(getFilePath(page->meta.LPub.page.plugImage.file.value()));
           if (fileInfo.exists()) {
               QPixmap qpixmap;
-              qpixmap.load(fileInfo.absoluteFilePath());
+              PageAttributePixmapItem::loadPixmap(fileInfo.absoluteFilePath(),qpixmap);
               pixmapPlugImageBack =
                       new PageAttributePixmapItem(
                           page,
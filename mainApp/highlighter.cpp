@@ -30,9 +30,107 @@
 #include "application.h"
 #include "name.h"
 
+QVector<Highlighter::HighlightingRule> Highlighter::highlightingRules;
+QList<QTextCharFormat> Highlighter::lineType1Formats;
+QTextCharFormat Highlighter::LDrawLineType2_5Format;
+QString Highlighter::highlightingTheme;
+
 Highlighter::Highlighter(QTextDocument *parent)
     : QSyntaxHighlighter(parent)
+{
+    // the rules are compiled once and shared by all editors
+    if (highlightingRules.isEmpty() || highlightingTheme != Application::instance()->getTheme())
+        initHighlightingRules();
+}
+
+void Highlighter::appendRules(
+    const QStringList &patterns,
+    const QTextCharFormat &format,
+    QRegularExpression::PatternOptions options)
 {
+    HighlightingRule rule;
+    rule.format = format;
+
+    QStringList keywords;
+    for (const QString &pattern : patterns) {
+        // patterns spanning the line are matched on their own
+        if (pattern.contains(".*")) {
+            rule.pattern = QRegularExpression(pattern, options);
+            highlightingRules.append(rule);
+        } else if (!keywords.contains(pattern)) {
+            keywords << pattern;
+        }
+    }
+
+    // the rest in one alternation, longest first so multi-word
+    // keywords match before their leading keyword
+    std::stable_sort(keywords.begin(), keywords.end(), [](const QString &a, const QString &b) {
+        return a.size() > b.size();
+    });
+    rule.pattern = QRegularExpression("(?:" + keywords.join(")|(?:") + ")", options);
+    highlightingRules.append(rule);
+}
+
+void Highlighter::initHighlightingRules()
+{
+    highlightingTheme = Application::instance()->getTheme();
+    highlightingRules.clear();
+    lineType1Formats.clear();
+
+    QTextCharFormat LDrawCommentFormat;    // b01 - Comments
+
+    QTextCharFormat LPubLocalMetaFormat;   // b04 - LPub3D Local
+    QTextCharFormat LPubGlobalMetaFormat;  // b05 - LPub3D Global
+    QTextCharFormat LPubFalseMetaFormat;   // b22 - LPub3D False
+    QTextCharFormat LPubTrueMetaFormat;    // b23 - LPub3D True
+    QTextCharFormat LPubMetaFormat;        // b24 - LPub3D
+    QTextCharFormat LPubBodyMetaFormat;    // b25 - LPub3D Body
+    QTextCharFormat LPubQuotedTextFormat;  // b27 - LPub3D Quoted Text
+    QTextCharFormat LPubFontCommaFormat;   // b27 - LPub3D Quoted Text
+    QTextCharFormat LPubFontNumberFormat;  // b14 - LPub3D Number
+    QTextCharFormat LPubNumberFormat;      // b14 - LPub3D Number
+    QTextCharFormat LPubHexNumberFormat;   // b15 - LPub3D Hex Number
+    QTextCharFormat LPubPageSizeFormat;    // b16 - LPub3D Page Size
+    QTextCharFormat LPubSubPartFormat;     // b12 - LPub3D Part File
+    QTextCharFormat LPubSubColorFormat;    // b07 - LDraw Part Colour Code
+    QTextCharFormat LPubCustomColorFormat; // b07 - LDraw Part Colour Code
+
+    QTextCharFormat LDrawHeaderValueFormat;// b26 - LDraw Header Value
+    QTextCharFormat LDrawHeaderFormat;     // b02 - LDraw Header
+    QTextCharFormat LDrawBodyFormat;       // b03 - LDraw Body
+    QTextCharFormat LDrawColourMetaFormat; // b05 - LPub3D Global
+    QTextCharFormat LDrawColourDescFormat; // b26 - LDraw Header Value
+    QTextCharFormat LDrawLineType0Format;  // b28 - LDraw Line Type 0 First Character
+
+    // position 0
+    QTextCharFormat LDrawLineType1Format;  // b06 - LDraw Line Type 1
+    // position 1
+    QTextCharFormat LDrawColorFormat;      // b07 - LDraw Part Colour Code
+    // positions 2-4
+    QTextCharFormat LDrawPositionFormat;   // b08 - LDraw Part Position [x y z]
+    // transform1 5-7
+    QTextCharFormat LDrawTransform1Format; // b09 - LDraw Part Transform1 [a b c]
+    // transform2 8-10
+    QTextCharFormat LDrawTransform2Format; // b10 - LDraw Part Transform2 [d e f]
+    // transform3 11-13
+    QTextCharFormat LDrawTransform3Format; // b11 - LDraw Part Transform3 [g h i]
+    // ldraw file 14
+    QTextCharFormat LDrawFileFormat;       // b12 - LDraw Part File
+
+    QTextCharFormat LeoCADMetaFormat;      // b20 - LeoCAD
+    QTextCharFormat LeoCADBodyMetaFormat;  // b17 - LeoCAD
+
+    QTextCharFormat LSynthMetaFormat;      // b18 - LSynth
+
+    QTextCharFormat LDCadMetaKeyFormat;    // b11 - LDCad Key
+    QTextCharFormat LDCadMetaValueFormat;  // b18 - LDCad Value
+    QTextCharFormat LDCadBodyMetaFormat;   // b19 - LDCad
+    QTextCharFormat LDCadBracketFormat;    // b17 - LDCad Value Bracket
+    QTextCharFormat LDCadMetaGrpDefFormat; // b29 - LDCad Group Define
+
+    QTextCharFormat MLCadMetaFormat;       // b20 - MLCad
+    QTextCharFormat MLCadBodyMetaFormat;   // b21 - MLCad Body
+
     HighlightingRule rule;
 
     QBrush br01,br02,br03,br04,br05,br06,br07,br08,br09,br10,br11,br12,br13,br14;
@@ -104,70 +202,70 @@ Highlighter::Highlighter(QTextDocument *parent)
     // LPub3D Number Format
     LPubNumberFormat.setForeground(br14);
     LPubNumberFormat.setFontWeight(QFont::Normal);
-    rule.pattern = QRegExp("-?(?:0|[1-9]\\d*)(?:\\.\\d+)?");
+    rule.pattern = QRegularExpression("-?(?:0|[1-9]\\d*)(?:\\.\\d+)?");
     rule.format = LPubNumberFormat;
     highlightingRules.append(rule);
 
     // LDraw Custom COLOUR Description Format
     LDrawColourDescFormat.setForeground(br26);
     LDrawColourDescFormat.setFontWeight(QFont::Bold);
-    rule.pattern = QRegExp("\\bLPub3D_[A-Z|a-z|_]+\\b");
+    rule.pattern = QRegularExpression("\\bLPub3D_[A-Z|a-z|_]+\\b");
     rule.format = LDrawColourDescFormat;
     highlightingRules.append(rule);
 
     // LPub3D Quoted Text Format
     LPubQuotedTextFormat.setForeground(br27);
     LPubQuotedTextFormat.setFontWeight(QFont::Normal);
-    rule.pattern = QRegExp("\".*\"");
+    rule.pattern = QRegularExpression("\".*\"");
     rule.format = LPubQuotedTextFormat;
     highlightingRules.append(rule);
 
     // LPub3D Hex Number Format
     LPubHexNumberFormat.setForeground(br15);
     LPubHexNumberFormat.setFontWeight(QFont::Bold);
-    rule.pattern = QRegExp("#(?:[A-Fa-f0-9]{6}|[A-Fa-f0-9]{3})",Qt::CaseInsensitive);
+    rule.pattern = QRegularExpression("#(?:[A-Fa-f0-9]{6}|[A-Fa-f0-9]{3})",QRegularExpression::CaseInsensitiveOption);
     rule.format = LPubHexNumberFormat;
     highlightingRules.append(rule);
 
     // LPub3D Font Number Format
     LPubFontNumberFormat.setForeground(br14);
     LPubFontNumberFormat.setFontWeight(QFont::Normal);
-    rule.pattern = QRegExp("[,|-](\\d+)"); // match digit if preceded by single character , or -
+    rule.pattern = QRegularExpression("[,|-](\\d+)"); // match digit if preceded by single character , or -
     rule.format = LPubFontNumberFormat;
     highlightingRules.append(rule);
 
     // LPub3D Substitute Color Format
     LPubSubColorFormat.setForeground(br07);
     LPubSubColorFormat.setFontWeight(QFont::Bold);
-    rule.pattern = QRegExp("BEGIN\\sSUB\\s.*.[dat|mpd|ldr]\\s([0-9]+)",Qt::CaseInsensitive); // match color format if preceded by 'BEGIN SUB *.ldr|dat|mpd '
+    rule.pattern = QRegularExpression("BEGIN\\sSUB\\s.*.[dat|mpd|ldr]\\s([0-9]+)",QRegularExpression::CaseInsensitiveOption); // match color format if preceded by 'BEGIN SUB *.ldr|dat|mpd '
     rule.format = LPubSubColorFormat;
     highlightingRules.append(rule);
 
     // LPub3D Custom COLOUR Code Format
     LPubCustomColorFormat.setForeground(br07);
     LPubCustomColorFormat.setFontWeight(QFont::Bold);
-    rule.pattern = QRegExp("CODE\\s([0-9]+)\\sVALUE",Qt::CaseInsensitive); // match color format if preceded by 'CODE ' and followed by ' VALUE'
+    rule.pattern = QRegularExpression("CODE\\s([0-9]+)\\sVALUE",QRegularExpression::CaseInsensitiveOption); // match color format if preceded by 'CODE ' and followed by ' VALUE'
     rule.format = LPubCustomColorFormat;
     highlightingRules.append(rule);
 
     // LPub3D Substitute Part Format
     LPubSubPartFormat.setForeground(br12);
     LPubSubPartFormat.setFontWeight(QFont::Bold);
-    rule.pattern = QRegExp("BEGIN\\sSUB\\s([A-Za-z0-9\\s_-]+.[dat|mpd|ldr]+)",Qt::CaseInsensitive); // match part format if preceded by 'BEGIN SUB'
+    rule.pattern = QRegularExpression("BEGIN\\sSUB\\s([A-Za-z0-9\\s_-]+.[dat|mpd|ldr]+)",QRegularExpression::CaseInsensitiveOption); // match part format if preceded by 'BEGIN SUB'
     rule.format = LPubSubPartFormat;
     highlightingRules.append(rule);
 
     // LPub3D Font Number Comma Format
     LPubFontCommaFormat.setForeground(br27);
     LPubFontCommaFormat.setFontWeight(QFont::Normal);
-    rule.pattern = QRegExp("[,]");
+    rule.pattern = QRegularExpression("[,]");
     rule.format = LPubFontCommaFormat;
     highlightingRules.append(rule);
 
     // LPub3D Page Size Format
     LPubPageSizeFormat.setForeground(br16);
     LPubPageSizeFormat.setFontWeight(QFont::Bold);
-    rule.pattern = QRegExp("\\b[A|B][0-9]0?$\\b|\\bComm10E\\b$|\\bArch[1-3]\\b$",Qt::CaseInsensitive);
+    rule.pattern = QRegularExpression("\\b[A|B][0-9]0?$\\b|\\bComm10E\\b$|\\bArch[1-3]\\b$",QRegularExpression::CaseInsensitiveOption);
     rule.format = LPubPageSizeFormat;
     highlightingRules.append(rule);
 
@@ -184,11 +282,7 @@ Highlighter::Highlighter(QTextDocument *parent)
     << "\\bALPHA\\b"
     ;
 
-    foreach (QString pattern, LDrawColourPatterns) {
-        rule.pattern = QRegExp(pattern);
-        rule.format = LDrawColourMetaFormat;
-        highlightingRules.append(rule);
-    }
+    appendRules(LDrawColourPatterns, LDrawColourMetaFormat);
 
     // LDraw Body Format
     LDrawBodyFormat.setForeground(br03);
@@ -204,44 +298,40 @@ Highlighter::Highlighter(QTextDocument *parent)
     << "\\bWRITE\\b"
        ;
 
-    foreach (QString pattern, LDrawBodyPatterns) {
-        rule.pattern = QRegExp(pattern);
-        rule.format = LDrawBodyFormat;
-        highlightingRules.append(rule);
-    }
+    appendRules(LDrawBodyPatterns, LDrawBodyFormat);
 
     // LPub3D Meta Format
     LPubMetaFormat.setForeground(br24);
     LPubMetaFormat.setFontWeight(QFont::Bold);
-    rule.pattern = QRegExp("!?\\bLPUB\\b");
+    rule.pattern = QRegularExpression("!?\\bLPUB\\b");
     rule.format = LPubMetaFormat;
     highlightingRules.append(rule);
 
     // LPub3D Local Context Format
     LPubLocalMetaFormat.setForeground(br04);
     LPubLocalMetaFormat.setFontWeight(QFont::Bold);
-    rule.pattern = QRegExp("\\bLOCAL\\b");
+    rule.pattern = QRegularExpression("\\bLOCAL\\b");
     rule.format = LPubLocalMetaFormat;
     highlightingRules.append(rule);
 
     // LPub3D Global Context Format
     LPubGlobalMetaFormat.setForeground(br05);
     LPubGlobalMetaFormat.setFontWeight(QFont::Bold);
-    rule.pattern = QRegExp("\\bGLOBAL\\b");
+    rule.pattern = QRegularExpression("\\bGLOBAL\\b");
     rule.format = LPubGlobalMetaFormat;
     highlightingRules.append(rule);
 
     // LPub3D Boolean False Format
     LPubFalseMetaFormat.setForeground(br22);
     LPubFalseMetaFormat.setFontWeight(QFont::Bold);
-    rule.pattern = QRegExp("\\bFALSE\\b");
+    rule.pattern = QRegularExpression("\\bFALSE\\b");
     rule.format = LPubFalseMetaFormat;
     highlightingRules.append(rule);
 
     // LPub3D Boolean True Format
     LPubTrueMetaFormat.setForeground(br23);
     LPubTrueMetaFormat.setFontWeight(QFont::Bold);
-    rule.pattern = QRegExp("\\bTRUE\\b");
+    rule.pattern = QRegularExpression("\\bTRUE\\b");
     rule.format = LPubTrueMetaFormat;
     highlightingRules.append(rule);
 
@@ -600,16 +690,12 @@ Highlighter::Highlighter(QTextDocument *parent)
     << "\\bZNEAR\\b"
        ;
 
-    foreach (QString pattern, LPubBodyMetaPatterns) {
-        rule.pattern = QRegExp(pattern);
-        rule.format = LPubBodyMetaFormat;
-        highlightingRules.append(rule);
-    }
+    appendRules(LPubBodyMetaPatterns, LPubBodyMetaFormat);
 
     // LDraw Header Value Format
     LDrawHeaderValueFormat.setForeground(br26);
     LDrawHeaderValueFormat.setFontWeight(QFont::Normal);
-    rule.pattern = QRegExp("^(?!0 !LPUB|1).*\\b(?:AUTHOR|CATEGORY|CMDLINE|HELP|HISTORY|KEYWORDS|LDRAW_ORG|LICENSE|NAME|FILE|THEME|~MOVED TO)\\b.*$",Qt::CaseInsensitive);
+    rule.pattern = QRegularExpression("^(?!0 !LPUB|1).*\\b(?:AUTHOR|CATEGORY|CMDLINE|HELP|HISTORY|KEYWORDS|LDRAW_ORG|LICENSE|NAME|FILE|THEME|~MOVED TO)\\b.*$",QRegularExpression::CaseInsensitiveOption);
     rule.format = LDrawHeaderValueFormat;
     highlightingRules.append(rule);
 
@@ -665,30 +751,23 @@ Highlighter::Highlighter(QTextDocument *parent)
     << "\\b~MOVED TO\\b"
        ;
 
-    foreach (QString pattern, LDrawHeaderPatterns) {
-        rule.pattern = QRegExp(pattern,Qt::CaseInsensitive);
-        rule.format = LDrawHeaderFormat;
-        highlightingRules.append(rule);
-    }
+    appendRules(LDrawHeaderPatterns, LDrawHeaderFormat, QRegularExpression::CaseInsensitiveOption);
 
     // LDraw Meta Line Format
     LDrawLineType0Format.setForeground(br28);
     LDrawLineType0Format.setFontWeight(QFont::Normal);
-    rule.pattern = QRegExp("^0");
+    rule.pattern = QRegularExpression("^0");
     rule.format = LDrawLineType0Format;
     highlightingRules.append(rule);
 
     // LDraw Lines 2-5 Format
     LDrawLineType2_5Format.setForeground(br13);
     LDrawLineType2_5Format.setFontWeight(QFont::Bold);
-    rule.pattern = QRegExp("^[2-5][^\n]*");
-    rule.format = LDrawLineType2_5Format;
-    highlightingRules.append(rule);
 
     // MLCad Meta Format
     MLCadMetaFormat.setForeground(br21);
     MLCadMetaFormat.setFontWeight(QFont::Bold);
-    rule.pattern = QRegExp("!?\\bMLCAD\\b");
+    rule.pattern = QRegularExpression("!?\\bMLCAD\\b");
     rule.format = MLCadMetaFormat;
     highlightingRules.append(rule);
 
@@ -715,23 +794,19 @@ Highlighter::Highlighter(QTextDocument *parent)
     << "\\bSTORE\\b"
        ;
 
-    foreach (QString pattern, MLCadBodyMetaPatterns) {
-        rule.pattern = QRegExp(pattern);
-        rule.format = MLCadBodyMetaFormat;
-        highlightingRules.append(rule);
-    }
+    appendRules(MLCadBodyMetaPatterns, MLCadBodyMetaFormat);
 
     // LSynth Format
     LSynthMetaFormat.setForeground(br18);
     LSynthMetaFormat.setFontWeight(QFont::Bold);
-    rule.pattern = QRegExp("!?\\bSYNTH\\b[^\n]*");
+    rule.pattern = QRegularExpression("!?\\bSYNTH\\b[^\n]*");
     rule.format = LSynthMetaFormat;
     highlightingRules.append(rule);
 
     // LDCad Meta Key Format
     LDCadMetaKeyFormat.setForeground(br11);
     LDCadMetaKeyFormat.setFontWeight(QFont::Bold);
-    rule.pattern = QRegExp("!?\\bLDCAD\\b[^\n]*");
+    rule.pattern = QRegularExpression("!?\\bLDCAD\\b[^\n]*");
     rule.format = LDCadMetaKeyFormat;
     highlightingRules.append(rule);
 
@@ -749,37 +824,33 @@ Highlighter::Highlighter(QTextDocument *parent)
     << "(?<=LDCAD )\\bGROUP_NXT\\b"
     ;
 
-    foreach (QString pattern, LDCadBodyMetaPatterns) {
-        rule.pattern = QRegExp(pattern);
-        rule.format = LDCadBodyMetaFormat;
-        highlightingRules.append(rule);
-    }
+    appendRules(LDCadBodyMetaPatterns, LDCadBodyMetaFormat);
 
     // LDCad Meta Value Format
     LDCadMetaValueFormat.setForeground(br08);
     LDCadMetaValueFormat.setFontWeight(QFont::Normal);
-    rule.pattern = QRegExp("[=]([a-zA-Z\\0-9%.\\s]+)");
+    rule.pattern = QRegularExpression("[=]([a-zA-Z\\0-9%.\\s]+)");
     rule.format = LDCadMetaValueFormat;
     highlightingRules.append(rule);
 
     // LDCad Meta Group Def Format
     LDCadMetaGrpDefFormat.setForeground(br29);
     LDCadMetaGrpDefFormat.setFontWeight(QFont::Bold);
-    rule.pattern = QRegExp("!?\\bLDCAD GROUP_DEF\\b");
+    rule.pattern = QRegularExpression("!?\\bLDCAD GROUP_DEF\\b");
     rule.format = LDCadMetaGrpDefFormat;
     highlightingRules.append(rule);
 
     // LDCad Value Bracket Format
     LDCadBracketFormat.setForeground(br17);
     LDCadBracketFormat.setFontWeight(QFont::Bold);
-    rule.pattern = QRegExp("[\\[|=|\\]]");
+    rule.pattern = QRegularExpression("[\\[|=|\\]]");
     rule.format = LDCadBracketFormat;
     highlightingRules.append(rule);
 
     // LeoCAD Format
     LeoCADMetaFormat.setForeground(br20);
     LeoCADMetaFormat.setFontWeight(QFont::Bold);
-    rule.pattern = QRegExp("!?\\bLEOCAD\\b[^\n]*");
+    rule.pattern = QRegularExpression("!?\\bLEOCAD\\b[^\n]*");
     rule.format = LeoCADMetaFormat;
     highlightingRules.append(rule);
 
@@ -818,16 +889,12 @@ Highlighter::Highlighter(QTextDocument *parent)
     << "(?<=LEOCAD )\\bGROUP END\\b"
     ;
 
-    foreach (QString pattern, LeoCADBodyMetaPatterns) {
-        rule.pattern = QRegExp(pattern);
-        rule.format = LeoCADBodyMetaFormat;
-        highlightingRules.append(rule);
-    }
+    appendRules(LeoCADBodyMetaPatterns, LeoCADBodyMetaFormat);
 
     // LDraw Comment Format
     LDrawCommentFormat.setForeground(br01);
     LDrawCommentFormat.setFontWeight(QFont::Normal);
-    rule.pattern = QRegExp("0\\s+\\/\\/[^\n]*",Qt::CaseInsensitive);
+    rule.pattern = QRegularExpression("0\\s+\\/\\/[^\n]*",QRegularExpression::CaseInsensitiveOption);
     rule.format = LDrawCommentFormat;
     highlightingRules.append(rule);
 
@@ -865,34 +932,45 @@ Highlighter::Highlighter(QTextDocument *parent)
     LDrawFileFormat.setForeground(br12);
     LDrawFileFormat.setFontWeight(QFont::Bold);
     lineType1Formats.append(LDrawFileFormat);
+
+    for (HighlightingRule &highlightingRule : highlightingRules)
+        highlightingRule.pattern.optimize();
 }
 
 void Highlighter::highlightBlock(const QString &text)
 {
-    // apply the predefined rules
-    foreach (HighlightingRule rule, highlightingRules) {
-        QRegExp expression(rule.pattern);
-        int index = text.indexOf(expression);
-        while (index >= 0) {
-            int length = expression.matchedLength();
-            setFormat(index, length, rule.format);
-            index = text.indexOf(expression, index + length);
-        }
-    }
-
     setCurrentBlockState(0);
 
+    // dispatch by line type - part lines are formatted by position
+    // and lines 2-5 as a whole, so only meta lines go through the rules
     int index = -1;
-    if (text.startsWith("1 "))
+    const QChar lineType = text.isEmpty() ? QChar() : text.at(0);
+    if (text.startsWith("1 ")) {
         index = 0;
-    else if (text.startsWith("0 GHOST "))
-        index = 8;
-    else if (text.startsWith("0 MLCAD HIDE "))
-        index = 13;
-    else
+    } else if (lineType >= '2' && lineType <= '5') {
+        setFormat(0, text.length(), LDrawLineType2_5Format);
         return;
+    } else {
+        // apply the predefined rules
+        for (const HighlightingRule &rule : highlightingRules) {
+            QRegularExpressionMatchIterator matches = rule.pattern.globalMatch(text);
+            while (matches.hasNext()) {
+                QRegularExpressionMatch match = matches.next();
+                setFormat(match.capturedStart(), match.capturedLength(), rule.format);
+            }
+        }
+
+        if (text.startsWith("0 GHOST "))
+            index = 8;
+        else if (text.startsWith("0 MLCAD HIDE "))
+            index = 13;
+        else
+            return;
+    }
 
     QStringList tt = text.mid(index).trimmed().split(" ",QString::SkipEmptyParts);
+    if (tt.size() < 14)
+        return;
     QString part;
     for (int t = 14; t < tt.size(); t++)
         part += (tt[t]+" ");
@@ -33,6 +33,7 @@
 
 #include <QTextCharFormat>
 #include <QSyntaxHighlighter>
+#include <QRegularExpression>
 #include <QHash>
 
 class QTextDocument;
@@ -52,71 +53,20 @@ private:
 
     struct HighlightingRule
     {
-        QRegExp pattern;
+        QRegularExpression pattern;
         QTextCharFormat format;
     };
 
-    QVector<HighlightingRule> highlightingRules;
-    QList<QTextCharFormat> lineType1Formats;
-
-    QTextCharFormat LDrawCommentFormat;    // b01 - Comments
-
-    QTextCharFormat LPubLocalMetaFormat;   // b04 - LPub3D Local
-    QTextCharFormat LPubGlobalMetaFormat;  // b05 - LPub3D Global
-    QTextCharFormat LPubFalseMetaFormat;   // b22 - LPub3D False
-    QTextCharFormat LPubTrueMetaFormat;    // b23 - LPub3D True
-    QTextCharFormat LPubMetaFormat;        // b24 - LPub3D
-    QTextCharFormat LPubBodyMetaFormat;    // b25 - LPub3D Body
-    QTextCharFormat LPubQuotedTextFormat;  // b27 - LPub3D Quoted Text
-    QTextCharFormat LPubFontCommaFormat;   // b27 - LPub3D Quoted Text
-    QTextCharFormat LPubFontNumberFormat;  // b14 - LPub3D Number
-    QTextCharFormat LPubNumberFormat;      // b14 - LPub3D Number
-    QTextCharFormat LPubHexNumberFormat;   // b15 - LPub3D Hex Number
-    QTextCharFormat LPubPageSizeFormat;    // b16 - LPub3D Page Size
-    QTextCharFormat LPubSubPartFormat;     // b12 - LPub3D Part File
-    QTextCharFormat LPubSubColorFormat;    // b07 - LDraw Part Colour Code
-    QTextCharFormat LPubCustomColorFormat; // b07 - LDraw Part Colour Code
-
-    QTextCharFormat LDrawHeaderValueFormat;// b26 - LDraw Header Value
-    QTextCharFormat LDrawHeaderFormat;     // b02 - LDraw Header
-    QTextCharFormat LDrawBodyFormat;       // b03 - LDraw Body
-    QTextCharFormat LDrawColourMetaFormat; // b05 - LPub3D Global
-    QTextCharFormat LDrawColourDescFormat; // b26 - LDraw Header Value
-    QTextCharFormat LDrawLineType0Format;  // b28 - LDraw Line Type 0 First Character
-
-    // position 0
-    QTextCharFormat LDrawLineType1Format;  // b06 - LDraw Line Type 1
-    // position 1
-    QTextCharFormat LDrawColorFormat;      // b07 - LDraw Part Colour Code
-    // positions 2-4
-    QTextCharFormat LDrawPositionFormat;   // b08 - LDraw Part Position [x y z]
-    // transform1 5-7
-    QTextCharFormat LDrawTransform1Format; // b09 - LDraw Part Transform1 [a b c]
-    // transform2 8-10
-    QTextCharFormat LDrawTransform2Format; // b10 - LDraw Part Transform2 [d e f]
-    // transform3 11-13
-    QTextCharFormat LDrawTransform3Format; // b11 - LDraw Part Transform3 [g h i]
-    // ldraw file 14
-    QTextCharFormat LDrawFileFormat;       // b12 - LDraw Part File
-
-    QTextCharFormat LDrawLineType2_5Format;// b13 - LDraw Line Types 2-5
-    QTextCharFormat LDrawLineType3Format;  // bXX - LDraw Triangle Line       [not used]
-    QTextCharFormat LDrawLineType4Format;  // bXX - LDraw Quadrilateral Line  [not used]
-    QTextCharFormat LDrawLineType5Format;  // bXX - LDraw Optional Line Line  [not used]
-
-    QTextCharFormat LeoCADMetaFormat;      // b20 - LeoCAD
-    QTextCharFormat LeoCADBodyMetaFormat;  // b17 - LeoCAD
-
-    QTextCharFormat LSynthMetaFormat;      // b18 - LSynth
-
-    QTextCharFormat LDCadMetaKeyFormat;    // b11 - LDCad Key
-    QTextCharFormat LDCadMetaValueFormat;  // b18 - LDCad Value
-    QTextCharFormat LDCadBodyMetaFormat;   // b19 - LDCad
-    QTextCharFormat LDCadBracketFormat;    // b17 - LDCad Value Bracket
-    QTextCharFormat LDCadMetaGrpDefFormat; // b29 - LDCad Group Define
-
-    QTextCharFormat MLCadMetaFormat;       // b20 - MLCad
-    QTextCharFormat MLCadBodyMetaFormat;   // b21 - MLCad Body
+    static void initHighlightingRules();
+    static void appendRules(const QStringList &patterns,
+                            const QTextCharFormat &format,
+                            QRegularExpression::PatternOptions options = QRegularExpression::NoPatternOption);
+
+    // shared by all instances, compiled once per theme
+    static QVector<HighlightingRule> highlightingRules;
+    static QList<QTextCharFormat> lineType1Formats;
+    static QTextCharFormat LDrawLineType2_5Format; // b13 - LDraw Line Types 2-5
+    static QString highlightingTheme;
 
 };
 
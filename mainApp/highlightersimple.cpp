@@ -30,9 +30,46 @@
 #include "application.h"
 #include "name.h"
 
+QVector<HighlighterSimple::HighlightingRule> HighlighterSimple::highlightingRules;
+QString HighlighterSimple::highlightingTheme;
+
 HighlighterSimple::HighlighterSimple(QTextDocument *parent)
     : QSyntaxHighlighter(parent)
 {
+    // the rules are compiled once and shared by all editors
+    if (highlightingRules.isEmpty() || highlightingTheme != Application::instance()->getTheme())
+        initHighlightingRules();
+}
+
+void HighlighterSimple::appendRules(
+    const QStringList &patterns,
+    const QTextCharFormat &format,
+    QRegularExpression::PatternOptions options)
+{
+    // one alternation per format, longest first
+    QStringList keywords = patterns;
+    keywords.removeDuplicates();
+    std::stable_sort(keywords.begin(), keywords.end(), [](const QString &a, const QString &b) {
+        return a.size() > b.size();
+    });
+
+    HighlightingRule rule;
+    rule.pattern = QRegularExpression("(?:" + keywords.join(")|(?:") + ")", options);
+    rule.format = format;
+    highlightingRules.append(rule);
+}
+
+void HighlighterSimple::initHighlightingRules()
+{
+    highlightingTheme = Application::instance()->getTheme();
+    highlightingRules.clear();
+
+    QTextCharFormat LDrawCommentFormat; // b01  - Comments      Qt::darkGreen
+    QTextCharFormat LDrawHeaderFormat;  // b02  - LDraw Header  Qt::blue
+    QTextCharFormat ModuleMetaFormat;   // br17 - MLCad         Qt::darkBlue
+    QTextCharFormat LPubMetaFormat;     // br25 - LPub Meta     Qt::darkRed
+    QTextCharFormat LSynthMetaFormat;   // br22 - LSynth Meta   Qt::red
+
     HighlightingRule rule;
     
     QBrush br01,br03,br17,br22,br25;
@@ -88,11 +125,7 @@ HighlighterSimple::HighlighterSimple(QTextDocument *parent)
     << "\\b~MOVED TO[^\n]*"
        ;
 
-    foreach (QString pattern, LDrawHeaderPatterns) {
-        rule.pattern = QRegExp(pattern,Qt::CaseInsensitive);
-        rule.format = LDrawHeaderFormat;
-        highlightingRules.append(rule);
-    }
+    appendRules(LDrawHeaderPatterns, LDrawHeaderFormat, QRegularExpression::CaseInsensitiveOption);
     
     // Module (MLCAD, LeoCAD, LDCAD Meta Format
     ModuleMetaFormat.setForeground(br17);   // Qt::darkBlue
@@ -123,12 +156,7 @@ HighlighterSimple::HighlighterSimple(QTextDocument *parent)
     << "\\b!LEOCAD\\b[^\n]*"
       ;
 
-    foreach (QString pattern, ModuleMetaPatterns) {
-        rule.pattern = QRegExp(pattern);
-        rule.format = ModuleMetaFormat;
-
-        highlightingRules.append(rule);
-    }
+    appendRules(ModuleMetaPatterns, ModuleMetaFormat);
 
     // LPub Meta Format
     LPubMetaFormat.setForeground(br25);  // Qt::darkRed
@@ -141,12 +169,7 @@ HighlighterSimple::HighlighterSimple(QTextDocument *parent)
     << "\\bPLIST\\b[^\n]*"
        ;
 
-    foreach (QString pattern, LPubMetaPatterns) {
-        rule.pattern = QRegExp(pattern);
-        rule.format = LPubMetaFormat;
-
-        highlightingRules.append(rule);
-    }
+    appendRules(LPubMetaPatterns, LPubMetaFormat);
 
     // LSynth Meta Format
     LSynthMetaFormat.setForeground(br22);     // Qt::red
@@ -158,31 +181,26 @@ HighlighterSimple::HighlighterSimple(QTextDocument *parent)
     << "\\b!SYNTH\\b[^\n]*"
        ;
 
-    foreach (QString pattern, LSynthMetaPatterns) {
-        rule.pattern = QRegExp(pattern);
-        rule.format = LSynthMetaFormat;
-
-        highlightingRules.append(rule);
-    }
+    appendRules(LSynthMetaPatterns, LSynthMetaFormat);
 
     // LDraw Comment Format
     LDrawCommentFormat.setForeground(br01);           // Qt::darkGreen
     LDrawCommentFormat.setFontWeight(QFont::Normal);
-    rule.pattern = QRegExp("0\\s+\\/\\/[^\n]*",Qt::CaseInsensitive);
+    rule.pattern = QRegularExpression("0\\s+\\/\\/[^\n]*",QRegularExpression::CaseInsensitiveOption);
     rule.format  = LDrawCommentFormat;
     highlightingRules.append(rule);
+
+    for (HighlightingRule &highlightingRule : highlightingRules)
+        highlightingRule.pattern.optimize();
 }
 
 void HighlighterSimple::highlightBlock(const QString &text)
 {
-    foreach (HighlightingRule rule, highlightingRules) {
-        QRegExp expression(rule.pattern);
-
-        int index = text.indexOf(expression);
-        while (index >= 0) {
-            int length = expression.matchedLength();
-            setFormat(index, length, rule.format);
-            index = text.indexOf(expression, index + length);
+    for (const HighlightingRule &rule : highlightingRules) {
+        QRegularExpressionMatchIterator matches = rule.pattern.globalMatch(text);
+        while (matches.hasNext()) {
+            QRegularExpressionMatch match = matches.next();
+            setFormat(match.capturedStart(), match.capturedLength(), rule.format);
         }
     }
 }
@@ -32,6 +32,7 @@
 #define HIGHLIGHTERSIMPLE_H
 
 #include <QSyntaxHighlighter>
+#include <QRegularExpression>
 #include <QHash>
 #include <QTextCharFormat>
 
@@ -51,17 +52,18 @@ protected:
 private:
     struct HighlightingRule
     {
-        QRegExp pattern;
+        QRegularExpression pattern;
         QTextCharFormat format;
     };
 
-    QVector<HighlightingRule> highlightingRules;
+    static void initHighlightingRules();
+    static void appendRules(const QStringList &patterns,
+                            const QTextCharFormat &format,
+                            QRegularExpression::PatternOptions options = QRegularExpression::NoPatternOption);
 
-    QTextCharFormat LDrawCommentFormat; // b01  - Comments      Qt::darkGreen
-    QTextCharFormat LDrawHeaderFormat;  // b02  - LDraw Header  Qt::blue
-    QTextCharFormat ModuleMetaFormat;   // br17 - MLCad         Qt::darkBlue
-    QTextCharFormat LPubMetaFormat;     // br25 - LPub Meta     Qt::darkRed
-    QTextCharFormat LSynthMetaFormat;   // br22 - LSynth Meta   Qt::red
+    // shared by all instances, compiled once per theme
+    static QVector<HighlightingRule> highlightingRules;
+    static QString highlightingTheme;
 };
 
 #endif
@@ -16,6 +16,7 @@
 #include <QFileInfo>
 #include <QTextStream>
 #include "lpub_preferences.h"
+#include "partattributes.h"
 #include "QsLog.h"
 
 QHash<QString, QString>  LDrawColourParts::ldrawColourParts;
@@ -23,6 +24,7 @@ QHash<QString, QString>  LDrawColourParts::ldrawColourParts;
 bool LDrawColourParts::LDrawColorPartsLoad(QString &result)
 {
     ldrawColourParts.clear();
+    PartAttributes::clear();
     QString colorPartsFile = Preferences::ldrawColourPartsFile;
     QFile file(colorPartsFile);
     if ( ! file.open(QFile::ReadOnly | QFile::Text)) {
@@ -85,6 +87,7 @@ void LDrawColourParts::addLDrawColorPart(QString part)
     QString partFile = part.toLower().trimmed();
     QString partEntry = QString("g:::%1").arg(partFile);  // partLibType is 'g' Generated
     ldrawColourParts.insert(partFile, partEntry);
+    PartAttributes::clear();
     logTrace() << "Add generated colour part: " << partEntry.replace(":::", " ");
 }
 
@@ -96,4 +99,5 @@ void LDrawColourParts::clearGeneratedColorParts()
         if (i.value().at(0) == QChar('g'))
             ldrawColourParts.remove(i.key());
     }
+    PartAttributes::clear();
 }
@@ -39,9 +39,12 @@
 #include <QFile>
 #include <QRegExp>
 #include <QHash>
+#include <QSaveFile>
+#include <QtConcurrent>
 #include <functional>
 
 #include "paths.h"
+#include "partattributes.h"
 
 #include "lpub.h"
 #include "ldrawfilesload.h"
@@ -199,6 +202,7 @@ void LDrawFile::empty()
   _loadedParts.clear();
   _mpd                   = false;
   _partCount             = 0;
+  _version++;
   _buildModNextStepIndex = -1;
   _buildModPrevStepIndex =  0;
 }
@@ -265,6 +269,7 @@ void LDrawFile::insert(const QString &mcFileName,
   }
   LDrawSubFile subFile(contents,datetime,unofficialPart,generated,includeFile,subFilePath);
   _subFiles.insert(fileName,subFile);
+  _version++;
   if (includeFile)
       _includeFileList << fileName;
   else
@@ -468,6 +473,7 @@ void LDrawFile::setContents(const QString     &mcFileName,
     //i.value()._datetime = QDateTime::currentDateTime();
     i.value()._contents = contents;
     i.value()._changedSinceLastWrite = true;
+    _version++;
   }
 }
 
@@ -699,6 +705,7 @@ void LDrawFile::insertLine(const QString &mcFileName, int lineNumber, const QStr
 
   if (i != _subFiles.end()) {
     i.value()._contents.insert(lineNumber,line);
+    _version++;
     i.value()._modified = true;
  //   i.value()._datetime = QDateTime::currentDateTime();
     i.value()._changedSinceLastWrite = true;
@@ -712,6 +719,7 @@ void LDrawFile::replaceLine(const QString &mcFileName, int lineNumber, const QSt
 
   if (i != _subFiles.end()) {
     i.value()._contents[lineNumber] = line;
+    _version++;
     i.value()._modified = true;
 //    i.value()._datetime = QDateTime::currentDateTime();
     i.value()._changedSinceLastWrite = true;
@@ -725,6 +733,7 @@ void LDrawFile::deleteLine(const QString &mcFileName, int lineNumber)
 
   if (i != _subFiles.end()) {
     i.value()._contents.removeAt(lineNumber);
+    _version++;
     i.value()._modified = true;
 //    i.value()._datetime = QDateTime::currentDateTime();
     i.value()._changedSinceLastWrite = true;
@@ -745,6 +754,84 @@ void LDrawFile::changeContents(const QString &mcFileName,
   }
 }
 
+/* return an immutable copy-on-write view of the current content */
+
+LDrawFileSnapshot LDrawFile::snapshot() const
+{
+  LDrawFileSnapshot snapshot;
+  snapshot._subFiles        = _subFiles;
+  snapshot._subFileOrder    = _subFileOrder;
+  snapshot._includeFileList = _includeFileList;
+  snapshot._mpd             = _mpd;
+  snapshot._version         = _version;
+  return snapshot;
+}
+
+QString LDrawFileSnapshot::topLevelFile() const
+{
+  if (_subFileOrder.size())
+    return _subFileOrder[0];
+  return QString();
+}
+
+int LDrawFileSnapshot::size(const QString &mcFileName) const
+{
+  QMap<QString, LDrawSubFile>::const_iterator i = _subFiles.constFind(mcFileName.toLower());
+  if (i != _subFiles.constEnd())
+    return i.value()._contents.size();
+  return 0;
+}
+
+QString LDrawFileSnapshot::readLine(const QString &mcFileName, int lineNumber) const
+{
+  QMap<QString, LDrawSubFile>::const_iterator i = _subFiles.constFind(mcFileName.toLower());
+  if (i != _subFiles.constEnd()) {
+    if (lineNumber > -1 && lineNumber < i.value()._contents.size())
+      return i.value()._contents.at(lineNumber);
+  }
+  return QString();
+}
+
+QStringList LDrawFileSnapshot::contents(const QString &mcFileName) const
+{
+  QMap<QString, LDrawSubFile>::const_iterator i = _subFiles.constFind(mcFileName.toLower());
+  if (i != _subFiles.constEnd())
+    return i.value()._contents;
+  return QStringList();
+}
+
+bool LDrawFileSnapshot::isSubmodel(const QString &mcFileName) const
+{
+  QMap<QString, LDrawSubFile>::const_iterator i = _subFiles.constFind(mcFileName.toLower());
+  if (i != _subFiles.constEnd())
+    return ! i.value()._unofficialPart && ! i.value()._generated;
+  return false;
+}
+
+int LDrawFileSnapshot::isIncludeFile(const QString &mcFileName) const
+{
+  QMap<QString, LDrawSubFile>::const_iterator i = _subFiles.constFind(mcFileName.toLower());
+  if (i != _subFiles.constEnd())
+    return i.value()._includeFile;
+  return 0;
+}
+
+int LDrawFileSnapshot::numSteps(const QString &mcFileName) const
+{
+  QMap<QString, LDrawSubFile>::const_iterator i = _subFiles.constFind(mcFileName.toLower());
+  if (i != _subFiles.constEnd())
+    return i.value()._numSteps;
+  return 0;
+}
+
+int LDrawFileSnapshot::getModelStartPageNumber(const QString &mcFileName) const
+{
+  QMap<QString, LDrawSubFile>::const_iterator i = _subFiles.constFind(mcFileName.toLower());
+  if (i != _subFiles.constEnd())
+    return i.value()._startPageNumber;
+  return 0;
+}
+
 /*  Only used by SubMeta::parse(...) to read fade or highlight content */
 
 QString LDrawFile::readConfiguredLine(const QString &mcFileName, int lineNumber)
@@ -1586,19 +1673,67 @@ void LDrawFile::loadLDRFile(const QString &path, const QString &fileName)
     }
 }
 
-bool LDrawFile::saveFile(const QString &fileName)
+QList<LDrawSaveFile> LDrawFile::saveFiles(const QString &fileName)
 {
-    QApplication::setOverrideCursor(Qt::WaitCursor);
-    bool rc;
     if (isIncludeFile(fileName)) {
-      rc = saveIncludeFile(fileName);
+      return saveIncludeFile(fileName);
     } else if (_mpd) {
-      rc = saveMPDFile(fileName);
+      return saveMPDFile(fileName);
     } else {
-      rc = saveLDRFile(fileName);
+      return saveLDRFile(fileName);
     }
+}
+
+bool LDrawFile::saveFile(const QString &fileName)
+{
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    const QString error = writeSaveFiles(saveFiles(fileName), _currFileIsUTF8);
     QApplication::restoreOverrideCursor();
-    return rc;
+    if (!error.isEmpty())
+        emit gui->messageSig(LOG_ERROR,error);
+    return error.isEmpty();
+}
+
+/*
+ * Collect the files to save on the calling thread and write them on a
+ * worker thread. Later edits do not affect the files being written.
+ * The future holds the error message, empty when the save succeeded.
+ */
+QFuture<QString> LDrawFile::saveFileInBackground(const QString &fileName)
+{
+    return QtConcurrent::run(&LDrawFile::writeSaveFiles, saveFiles(fileName), _currFileIsUTF8);
+}
+
+/*
+ * Each file is written to a temporary file in the target folder and
+ * renamed over the target once complete, so an interrupted save never
+ * leaves a truncated model file behind. This may run on a worker thread,
+ * so errors are returned to the caller rather than logged here.
+ */
+QString LDrawFile::writeSaveFiles(const QList<LDrawSaveFile> &files, bool utf8)
+{
+    for (const LDrawSaveFile &saveFile : files) {
+      QSaveFile file(saveFile._fileName);
+      if (!file.open(QFile::WriteOnly | QFile::Text)) {
+        return QString("Cannot write file %1:<br>%2.")
+                       .arg(saveFile._fileName)
+                       .arg(file.errorString());
+      }
+      QTextStream out(&file);
+      out.setCodec(utf8 ? QTextCodec::codecForName("UTF-8") : QTextCodec::codecForName("System"));
+      for (const QStringList &section : saveFile._sections) {
+        for (const QString &line : section) {
+          out << line << endl;
+        }
+      }
+      out.flush();
+      if (!file.commit()) {
+        return QString("Cannot write file %1:<br>%2.")
+                       .arg(saveFile._fileName)
+                       .arg(file.errorString());
+      }
+    }
+    return QString();
 }
  
 bool LDrawFile::mirrored(
@@ -1904,47 +2039,32 @@ void LDrawFile::countInstances()
 #endif
 }
 
-bool LDrawFile::saveMPDFile(const QString &fileName)
+QList<LDrawSaveFile> LDrawFile::saveMPDFile(const QString &fileName)
 {
-    QString writeFileName = fileName;
-    QFile file(writeFileName);
-    if (!file.open(QFile::WriteOnly | QFile::Text)) {
-        emit gui->messageSig(LOG_ERROR,QString("Cannot write file %1:<br>%2.")
-                             .arg(writeFileName)
-                             .arg(file.errorString()));
-        return false;
-    }
-
-    QTextStream out(&file);
-    out.setCodec(_currFileIsUTF8 ? QTextCodec::codecForName("UTF-8") : QTextCodec::codecForName("System"));
+    QList<LDrawSaveFile> files;
+    LDrawSaveFile mpdFile(fileName);
     for (int i = 0; i < _subFileOrder.size(); i++) {
       QString subFileName = _subFileOrder[i];
-      QMap<QString, LDrawSubFile>::iterator f = _subFiles.find(subFileName);
-      if (f != _subFiles.end() && ! f.value()._generated) {
+      QMap<QString, LDrawSubFile>::const_iterator f = _subFiles.constFind(subFileName);
+      if (f != _subFiles.constEnd() && ! f.value()._generated) {
         if (!f.value()._subFilePath.isEmpty()) {
-            file.close();
-            writeFileName = f.value()._subFilePath;
-            file.setFileName(writeFileName);
-            if (!file.open(QFile::WriteOnly | QFile::Text)) {
-                emit gui->messageSig(LOG_ERROR,QString("Cannot write file %1:<br>%2.")
-                                    .arg(writeFileName)
-                                    .arg(file.errorString()));
-                return false;
-            }
-
-            QTextStream out(&file);
-            out.setCodec(_currFileIsUTF8 ? QTextCodec::codecForName("UTF-8") : QTextCodec::codecForName("System"));
+          // include files are written to their own path, when changed
+          if (f.value()._modified) {
+            LDrawSaveFile subFile(f.value()._subFilePath);
+            subFile._sections << f.value()._contents;
+            files << subFile;
+          }
+          continue;
         }
         if (!f.value()._includeFile)
-          out << "0 FILE " << subFileName << endl;
-        for (int j = 0; j < f.value()._contents.size(); j++) {
-          out << f.value()._contents[j] << endl;
-        }
+          mpdFile._sections << QStringList(QString("0 FILE %1").arg(subFileName));
+        mpdFile._sections << f.value()._contents;
         if (!f.value()._includeFile)
-          out << "0 NOFILE " << endl;
+          mpdFile._sections << QStringList("0 NOFILE ");
       }
     }
-    return true;
+    files.prepend(mpdFile);
+    return files;
 }
 
 void LDrawFile::countParts(const QString &fileName) {
@@ -2020,7 +2140,7 @@ void LDrawFile::countParts(const QString &fileName) {
                 else if (isSubstitute(line, type))
                     countThisLine = !type.isEmpty();
 
-                bool partIncluded = !ExcludedParts::hasExcludedPart(type);
+                bool partIncluded = !PartAttributes::resolve(type).excluded;
 
                 if (countThisLine && lineIncluded && partIncluded) {
                     QString partString = "|" + type + "|";
@@ -2126,10 +2246,10 @@ void LDrawFile::countParts(const QString &fileName) {
 
 }
 
-bool LDrawFile::saveLDRFile(const QString &fileName)
+QList<LDrawSaveFile> LDrawFile::saveLDRFile(const QString &fileName)
 {
+    QList<LDrawSaveFile> files;
     QString path = QFileInfo(fileName).path();
-    QFile file;
 
     for (int i = 0; i < _subFileOrder.size(); i++) {
       QString writeFileName;
@@ -2138,58 +2258,33 @@ bool LDrawFile::saveLDRFile(const QString &fileName)
       } else {
         writeFileName = path + QDir::separator() + _subFileOrder[i];
       }
-      file.setFileName(writeFileName);
-      QMap<QString, LDrawSubFile>::iterator f = _subFiles.find(_subFileOrder[i]);
-      if (f != _subFiles.end() && ! f.value()._generated) {
+      QMap<QString, LDrawSubFile>::const_iterator f = _subFiles.constFind(_subFileOrder[i]);
+      if (f != _subFiles.constEnd() && ! f.value()._generated) {
         if (f.value()._modified) {
           if (!f.value()._subFilePath.isEmpty()) {
               writeFileName = f.value()._subFilePath;
-              file.setFileName(writeFileName);
           }
-          if (!file.open(QFile::WriteOnly | QFile::Text)) {
-            emit gui->messageSig(LOG_ERROR,QString("Cannot write file %1:<br>%2.")
-                                 .arg(writeFileName)
-                                 .arg(file.errorString()));
-            return false;
-          }
-          QTextStream out(&file);
-          out.setCodec(_currFileIsUTF8 ? QTextCodec::codecForName("UTF-8") : QTextCodec::codecForName("System"));
-          for (int j = 0; j < f.value()._contents.size(); j++) {
-            out << f.value()._contents[j] << endl;
-          }
-          file.close();
+          LDrawSaveFile ldrFile(writeFileName);
+          ldrFile._sections << f.value()._contents;
+          files << ldrFile;
         }
       }
     }
-    return true;
+    return files;
 }
 
-bool LDrawFile::saveIncludeFile(const QString &fileName){
+QList<LDrawSaveFile> LDrawFile::saveIncludeFile(const QString &fileName){
+    QList<LDrawSaveFile> files;
     QString includeFileName = fileName.toLower();
-    QMap<QString, LDrawSubFile>::iterator f = _subFiles.find(includeFileName);
-    if (f != _subFiles.end() && f.value()._includeFile) {
-      if (f.value()._modified) {
-        QFile file;
-        QString writeFileName;
-        if (!f.value()._subFilePath.isEmpty()) {
-            writeFileName = f.value()._subFilePath;
-            file.setFileName(writeFileName);
-        }
-        if (!file.open(QFile::WriteOnly | QFile::Text)) {
-          emit gui->messageSig(LOG_ERROR,QString("Cannot write file %1:<br>%2.")
-                               .arg(writeFileName)
-                               .arg(file.errorString()));
-          return false;
-        }
-        QTextStream out(&file);
-        out.setCodec(_currFileIsUTF8 ? QTextCodec::codecForName("UTF-8") : QTextCodec::codecForName("System"));
-        for (int j = 0; j < f.value()._contents.size(); j++) {
-          out << f.value()._contents[j] << endl;
-        }
-        file.close();
+    QMap<QString, LDrawSubFile>::const_iterator f = _subFiles.constFind(includeFileName);
+    if (f != _subFiles.constEnd() && f.value()._includeFile) {
+      if (f.value()._modified && !f.value()._subFilePath.isEmpty()) {
+        LDrawSaveFile includeFile(f.value()._subFilePath);
+        includeFile._sections << f.value()._contents;
+        files << includeFile;
       }
     }
-    return true;
+    return files;
 }
 
 bool LDrawFile::changedSinceLastWrite(const QString &fileName)
@@ -3045,6 +3140,8 @@ QList<QRegExp> LDrawUnofficialOtherRegExp;
 LDrawFile::LDrawFile()
 {
   _loadedParts.clear();
+  _version = 0;
+  _mpd     = false;
 
   {
     _fileRegExp
@@ -35,6 +35,7 @@
 #include <QMap>
 #include <QDateTime>
 #include <QList>
+#include <QFuture>
 
 #include "excludedparts.h"
 #include "stickerparts.h"
@@ -85,6 +86,56 @@ class LDrawSubFile {
     }
 };
 
+/*
+ * An immutable, versioned view of the loaded model. The submodel map and
+ * its line lists are implicitly shared with LDrawFile, so a snapshot costs
+ * a few reference counts to take and later edits detach on write instead
+ * of disturbing it. Take snapshots on the GUI thread; once taken they can
+ * be read from any thread while the user keeps editing.
+ */
+
+/*
+ * A file written by a model save. Sections hold implicitly shared copies
+ * of the submodel contents, so the file can be written on another thread
+ * while the model continues to be edited.
+ */
+class LDrawSaveFile {
+  public:
+    QString            _fileName;
+    QList<QStringList> _sections;
+
+    LDrawSaveFile() {}
+    LDrawSaveFile(const QString &fileName)
+      : _fileName(fileName) {}
+};
+
+class LDrawFileSnapshot {
+  private:
+    friend class LDrawFile;
+    QMap<QString, LDrawSubFile> _subFiles;
+    QStringList                 _subFileOrder;
+    QStringList                 _includeFileList;
+    bool                        _mpd;
+    int                         _version;
+
+  public:
+    LDrawFileSnapshot() : _mpd(false), _version(-1) {}
+
+    int  version() const { return _version; }
+    bool isValid() const { return _version > -1; }
+    bool isMpd() const { return _mpd; }
+    QStringList subFileOrder() const { return _subFileOrder; }
+    QStringList includeFileList() const { return _includeFileList; }
+    QString topLevelFile() const;
+    int  size(const QString &fileName) const;
+    QString readLine(const QString &fileName, int lineNumber) const;
+    QStringList contents(const QString &fileName) const;
+    bool isSubmodel(const QString &fileName) const;
+    int  isIncludeFile(const QString &fileName) const;
+    int  numSteps(const QString &fileName) const;
+    int  getModelStartPageNumber(const QString &fileName) const;
+};
+
 class CfgSubFile {
   public:
     QStringList  _contents;
@@ -189,6 +240,7 @@ class LDrawFile {
     QString                     _emptyString;
     int                         _buildModNextStepIndex;
     int                         _buildModPrevStepIndex;
+    int                         _version;
     bool                        _mpd;
     static int                  _emptyInt;
     static QList<QRegExp>       _fileRegExp;
@@ -242,9 +294,12 @@ class LDrawFile {
     static void showLoadMessages();
 
     bool saveFile(const QString &fileName);
-    bool saveMPDFile(const QString &filename);
-    bool saveLDRFile(const QString &filename);
-    bool saveIncludeFile(const QString &filename);
+    QFuture<QString> saveFileInBackground(const QString &fileName);
+    QList<LDrawSaveFile> saveMPDFile(const QString &filename);
+    QList<LDrawSaveFile> saveLDRFile(const QString &filename);
+    QList<LDrawSaveFile> saveIncludeFile(const QString &filename);
+    QList<LDrawSaveFile> saveFiles(const QString &fileName);
+    static QString writeSaveFiles(const QList<LDrawSaveFile> &files, bool utf8);
 
     void insert(const QString       &fileName,
                       QStringList   &contents,
@@ -257,6 +312,13 @@ class LDrawFile {
     int  size(const QString &fileName);
     void empty();
 
+    // bumped on every content change
+    int  version() const
+    {
+      return _version;
+    }
+    LDrawFileSnapshot snapshot() const;
+
     QStringList getSubModels();
     QStringList getSubFilePaths();
     QStringList contents(const QString &fileName);
@@ -54,6 +54,9 @@
 #include "aboutdialog.h"
 #include "dialogexportpages.h"
 #include "numberitem.h"
+#include "pagebackgrounditem.h"
+#include "pageimagecache.h"
+#include "pageattributepixmapitem.h"
 #include "progress_dialog.h"
 
 //3D Viewer
@@ -408,6 +411,12 @@ void Gui::displayPage()
     bool updateViewer = currentStep ? currentStep->updateViewer : true;
     clearPage(KpageView,KpageScene); // this includes freeSteps() so harvest old step items before calling
     drawPage(KpageView,KpageScene,false/*printing*/,updateViewer,false/*buildMod*/);
+    // a provisional page count can overshoot when pages were removed since the last traversal
+    if (displayPageNum > maxPages && maxPages > 0 && Preferences::modeGUI && ! exporting()) {
+      displayPageNum = maxPages;
+      clearPage(KpageView,KpageScene);
+      drawPage(KpageView,KpageScene,false/*printing*/,updateViewer,false/*buildMod*/);
+    }
     if (Preferences::modeGUI && ! exporting()) {
       enableActions2();
       emit enable3DActionsSig();
@@ -427,7 +436,9 @@ void Gui::nextPage()
       int inputPageNum;
       inputPageNum = rx.cap(1).toInt(&ok);
       if (ok && (inputPageNum != displayPageNum)) {		// numbers are different so jump to page
-          countPages();
+          countPages(true);
+          if (pageCountProvisional && inputPageNum > maxPages)
+              countPages();
           if (inputPageNum <= maxPages && inputPageNum != displayPageNum) {
               if (!saveBuildModification())
                   return;
@@ -441,7 +452,9 @@ void Gui::nextPage()
           setPageLineEdit->setText(string);
           return;
         } else {						// numbers are same so goto next page
-          countPages();
+          countPages(true);
+          if (pageCountProvisional && displayPageNum >= maxPages)
+              countPages();
           if (displayPageNum < maxPages) {
               if (!saveBuildModification())
                   return;
@@ -517,7 +530,7 @@ void Gui::previousPage()
       int inputPageNum;
       inputPageNum = rx.cap(1).toInt(&ok);
       if (ok && (inputPageNum != displayPageNum)) {		// numbers are different so jump to page
-          countPages();
+          countPages(true);
           if (inputPageNum >= 1 && inputPageNum != displayPageNum) {
               if (!saveBuildModification())
                   return;
@@ -973,7 +986,9 @@ void Gui::setPage()
     int inputPage;
     inputPage = rx.cap(1).toInt(&ok);
     if (ok) {
-      countPages();
+      countPages(true);
+      if (pageCountProvisional && inputPage > maxPages)
+          countPages();
       if (inputPage <= maxPages && inputPage != displayPageNum) {
           if (!saveBuildModification())
               return;
@@ -992,7 +1007,9 @@ void Gui::setPage()
 void Gui::setGoToPage(int index)
 {
   int goToPageNum = index+1;
-  countPages();
+  countPages(true);
+  if (pageCountProvisional && goToPageNum > maxPages)
+      countPages();
   if (goToPageNum <= maxPages && goToPageNum != displayPageNum) {
         if (!saveBuildModification())
             return;
@@ -1265,7 +1282,7 @@ void Gui::displayFile(
                 curSubFile = modelName;
 
             if (displayStartPage)
-                countPages();
+                countPages(true);
 
             int modelPageNum = ldrawFile->getModelStartPageNumber(modelName);
 
@@ -1365,7 +1382,7 @@ void Gui::mpdComboChanged(int index)
       if (!isIncludeFile) {
           int modelPageNum = ldrawFile.getModelStartPageNumber(newSubFile);
           messageSig(LOG_INFO, QString( "SELECT Model: %1 @ Page: %2").arg(newSubFile).arg(modelPageNum));
-          countPages();
+          countPages(true);
           if (modelPageNum && displayPageNum != modelPageNum) {
               if (!saveBuildModification())
                   return;
@@ -1530,6 +1547,9 @@ void Gui::clearAndRedrawModelFile() {
     clearSubmodelCache();
     clearTempCache();
 
+    BackgroundItem::clearPageBackgroundCache();
+    PageAttributePixmapItem::clearPixmapCache();
+
     //reload current model file
     int savePage = displayPageNum;
     openFile(curFile);
@@ -1658,6 +1678,10 @@ void Gui::clearPLICache()
             count++;
         }
     }
+    removeShardDirs(Paths::partsDir);
+    Render::clearRecolorCache();
+    PageImageCache::clear();
+
     emit messageSig(LOG_INFO_STATUS,QString("Parts content cache cleaned. %1 items removed.").arg(count));
 }
 
@@ -1687,6 +1711,10 @@ void Gui::clearCSICache()
         }
     }
 
+    removeShardDirs(Paths::assemDir);
+    Render::clearIncrementalRender();
+    PageImageCache::clear();
+
     emit messageSig(LOG_INFO_STATUS,QString("Assembly content cache cleaned. %1 items removed.").arg(count));
 }
 
@@ -1721,6 +1749,9 @@ void Gui::clearSubmodelCache(const QString &key)
         }
     }
 
+    if (key.isEmpty())
+        removeShardDirs(Paths::submodelDir);
+
     emit messageSig(LOG_INFO_STATUS,QString("Submodel content cache cleaned. %1 items removed.").arg(count));
 }
 
@@ -1750,6 +1781,7 @@ void Gui::clearTempCache()
         }
       }
 
+    removeShardDirs(Paths::tmpDir);
     ldrawFile.tempCacheCleared();
 
     emit messageSig(LOG_INFO_STATUS,QString("Temporary model file cache cleaned. %1 items removed.").arg(count1));
@@ -1786,6 +1818,22 @@ bool Gui::removeDir(int &count, const QString & dirName)
     return result;
 }
 
+/*
+ * Remove the shard_N folders pdf export workers (--export-shard) create
+ * under cacheDir for their own temp files and image caches.
+ */
+void Gui::removeShardDirs(const QString &cacheDir)
+{
+    QDir dir(QDir::currentPath() + "/" + cacheDir);
+    const QStringList shardDirs = dir.entryList(QStringList() << "shard_*", QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString &shardDir : shardDirs) {
+        int count = 0;
+        if (!removeDir(count, dir.absoluteFilePath(shardDir)))
+            emit messageSig(LOG_ERROR,QString("Unable to remove pdf export worker folder %1")
+                            .arg(dir.absoluteFilePath(shardDir)));
+    }
+}
+
 void Gui::clearStepCSICache(QString &pngName) {
   QString tmpDirName   = QDir::currentPath() + "/" + Paths::tmpDir;
   QString assemDirName = QDir::currentPath() + "/" + Paths::assemDir;
@@ -2936,6 +2984,9 @@ Gui::Gui()
     exportMode                      = EXPORT_PDF;
     pageRangeText                   = "1";
     exportPixelRatio                = 1.0;
+    exportWorkers                   = 0;
+    renderWorkers                   = 0;
+    saveWatcherIndex                = 0;
     resetCache                      = false;
     m_previewDialog                 = false;
     m_partListCSIFile               = false;
@@ -2944,6 +2995,9 @@ Gui::Gui()
     m_contPageProcessing            = false;
     nextPageContinuousIsRunning     = false;
     previousPageContinuousIsRunning = false;
+    pageCountProvisional            = false;
+    csiLineClassVersion             = -1;
+    submodelPageScanVersion         = -1;
 
     mBuildModRange    = { 0, 0, -1 };
     mStepRotation     = {0.0f, 0.0f, 0.0f};
@@ -3131,6 +3185,8 @@ Gui::Gui()
              this,          SLOT(  fileChanged(const QString &)));
     changeAccepted = true;
 #endif
+    connect(&saveWatcher,   SIGNAL(finished()),
+             this,          SLOT(  saveFileFinished()));
 
     gui = this;
 
@@ -3162,6 +3218,7 @@ void Gui::closeEvent(QCloseEvent *event)
     parmsWindow->close();
 
   if (maybeSave()) {
+      waitForSave();
       event->accept();
     } else {
       event->ignore();
@@ -339,6 +339,7 @@
 #include <QSettings>
 #include <QDateTime>
 #include <QFileSystemWatcher>
+#include <QFutureWatcher>
 #include <QtPrintSupport>
 #include <QFile>
 #include <QProgressBar>
@@ -523,6 +524,8 @@ public:
   int             processOption;    // export Option
   int             pageDirection;    // continuous page processing direction
   qreal           exportPixelRatio; // export resolution pixel density
+  int             exportWorkers;    // number of pdf export worker processes [commandline only]
+  int             renderWorkers;    // number of Native render worker processes [commandline only]
   QString         pageRangeText;    // page range parameters
   bool            submodelIconsLoaded; // load submodel images
   bool            resetCache;       // reset model, fade and highlight parts
@@ -614,6 +617,16 @@ public:
   {
     return ldrawFile.isSubmodel(modelName);
   }
+  // Consistent read-only copy of the model for background readers
+  LDrawFileSnapshot modelSnapshot()
+  {
+    return ldrawFile.snapshot();
+  }
+  // bumped on every model content change
+  int modelVersion()
+  {
+    return ldrawFile.version();
+  }
   bool isMpd()
   {
     return ldrawFile.isMpd();
@@ -1147,6 +1160,8 @@ public slots:
   int                    Process3DViewerCommandLine();
   bool                   OpenProject(const QString& FileName);
   bool                   ReloadUnofficialPiecesLibrary();
+  void                   PreloadModelPieces();
+  void                   ReleaseModelPieces();
   void                   LoadDefaults();
   void                   UpdateAllViews();
   void                   UnloadOfficialPiecesLibrary();
@@ -1300,6 +1315,7 @@ public slots:
   void resetModelCache(QString file = QString());
 
   bool removeDir(int &count,const QString &dirName);
+  void removeShardDirs(const QString &cacheDir);
 
   void fileChanged(const QString &path);
 
@@ -1450,6 +1466,9 @@ private:
                                              // being edited
   bool               changeAccepted;         // don't throw another message unless existing was accepted
 #endif
+  QFutureWatcher<QString> saveWatcher;       // background model file save, error message result
+  QString              saveWatcherFile;      // file name of the background save
+  int                  saveWatcherIndex;     // undo stack index when the background save started
 
   LDrawColor      ldrawColors;               // provides maps from ldraw color to RGB
 
@@ -1460,10 +1479,47 @@ private:
 
   bool            previousPageContinuousIsRunning;// stop the continuous previous page action
   bool            nextPageContinuousIsRunning;    // stop the continuous next page action
+  bool            pageCountProvisional;           // maxPages taken from the last traversal, not yet recounted
+
+  struct CsiLineClass {                           // configureModelStep per-line classification
+    QStringList   argv;                           // split line tokens
+    QString       line;                           // rejoined line, as written when not faded or highlighted
+    QString       fileName;                       // lower case type 1 part name
+    QString       extension;                      // lower case type 1 part name suffix
+    bool          type_1_line      = false;
+    bool          type_1_5_line    = false;
+    bool          is_colour_part   = false;
+    bool          is_submodel_file = false;
+    bool          is_ghost         = false;
+    QString       fadeLine;                       // faded rendition, made on the line's first faded step
+    QString       fadeColour;                     // fade colour of the faded rendition, empty for the part colour
+    QString       highlightLine;                  // highlighted rendition
+  };
+  QHash<QString, CsiLineClass> csiLineClasses;    // csi line, classification
+  int             csiLineClassVersion;            // ldrawFile version the classifications belong to
+
+  CsiLineClass &classifyCsiLine(const QString &csiLine);
+  QString colourCsiLine(const CsiLineClass &lc, const PartType partType, const QString &colourCode);
+
+  struct SubmodelPageScan {                       // findPage page structure of a submodel
+    QString       modelName;
+    QVector<int>  pageLines;                      // line number at the top of each following page
+    int           stepPages     = 0;              // pages closed by a STEP or ROTSTEP
+    int           numLines      = 0;
+    int           firstPartPage = -1;             // page offset of the first type 1 line
+    int           lastPartPage  = -1;             // page offset of the last type 1 line
+    bool          plain         = false;          // no submodel references or page shaping meta commands
+  };
+  QHash<QString, SubmodelPageScan> submodelPageScans; // lower case model name, page structure
+  int             submodelPageScanVersion;            // ldrawFile version the scans belong to
+
+  static void scanSubmodelPageLines(const LDrawFileSnapshot &snapshot, SubmodelPageScan &scan);
+  void scanSubmodelPages();
+  bool replaySubmodelPages(FindPageOptions &opts);
 
   bool isUserSceneObject(const int so);
 
-  void countPages();
+  void countPages(bool provisional = false);
 
   int findPage(                     // traverse the hierarchy until we get to the
     LGraphicsView   *view,          // page of interest, let traverse process the
@@ -1581,6 +1637,7 @@ private slots:
     void save();
     void saveAs();
     void saveCopy();
+    void saveFileFinished();
 
     void bringToFront();
     void sendToBack();
@@ -1719,6 +1776,8 @@ private slots:
     bool openFile(QString &fileName);
     bool maybeSave(bool prompt = true, int sender = SaveOnNone);
     bool saveFile(const QString &fileName);
+    void saveFileInBackground(const QString &fileName);
+    void waitForSave();
     void closeFile();
     void updateOpenWithActions();
     void updateRecentFileActions();
@@ -1727,6 +1786,8 @@ private slots:
     void disableWatcher();
 
 private:
+  bool exportAsPdfShards(const QString &baseName, QMap<int, QString> &pageImages);
+
   /* Initialization stuff */
 
   void createActions();
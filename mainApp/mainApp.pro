@@ -429,6 +429,7 @@ HEADERS += \
     pageattributepixmapitem.h \
     pageattributetextitem.h \
     pagebackgrounditem.h \
+    pageimagecache.h \
     pageorientationdialog.h \
     pagepointer.h \
     pagepointerbackgrounditem.h \
@@ -438,6 +439,7 @@ HEADERS += \
     pairdialog.h \
     parmshighlighter.h \
     parmswindow.h \
+    partattributes.h \
     paths.h \
     placement.h \
     placementdialog.h \
@@ -459,6 +461,7 @@ HEADERS += \
     ranges_item.h \
     render.h \
     renderdialog.h \
+    renderworkers.h \
     reserve.h \
     resize.h \
     resolution.h \
@@ -538,6 +541,7 @@ SOURCES += \
     pageattributetextitem.cpp \
     pagebackgrounditem.cpp \
     pageglobals.cpp \
+    pageimagecache.cpp \
     pageorientationdialog.cpp \
     pagepointer.cpp \
     pagepointerbackgrounditem.cpp \
@@ -547,6 +551,7 @@ SOURCES += \
     pairdialog.cpp \
     parmshighlighter.cpp \
     parmswindow.cpp \
+    partattributes.cpp \
     paths.cpp \
     placement.cpp \
     placementdialog.cpp \
@@ -570,6 +575,7 @@ SOURCES += \
     ranges_item.cpp \
     render.cpp \
     renderdialog.cpp \
+    renderworkers.cpp \
     resize.cpp \
     resolution.cpp \
     rotate.cpp \
@@ -1588,6 +1588,33 @@ void Gui::reloadViewer(){
      return lcGetPiecesLibrary()->ReloadUnoffLib();
  }
 
+ // queue the library parts referenced by the loaded model for background
+ // loading, so their meshes are parsed (and cached) before the first render
+ void Gui::PreloadModelPieces()
+ {
+     QStringList PieceNames;
+     QSet<QString> Seen;
+     for (const QString &ModelName : ldrawFile.subFileOrder()) {
+         const QStringList Contents = ldrawFile.contents(ModelName);
+         for (const QString &Line : Contents) {
+             QStringList Tokens;
+             if (split(Line, Tokens) < 0 || Tokens.size() != 15 || Tokens[0] != "1")
+                 continue;
+             const QString PieceName = Tokens[14].toLower();
+             if (Seen.contains(PieceName) || ldrawFile.contains(PieceName))
+                 continue;
+             Seen.insert(PieceName);
+             PieceNames << PieceName;
+         }
+     }
+     lcGetPiecesLibrary()->PreloadPieces(PieceNames);
+ }
+
+ void Gui::ReleaseModelPieces()
+ {
+     lcGetPiecesLibrary()->ReleasePreloadedPieces();
+ }
+
  int Gui::Process3DViewerCommandLine()
  {
      return gApplication->Process3DViewerCommandLine();
@@ -467,6 +467,7 @@ int Gui::whichFile(int option) {
 
 void Gui::save()
 {
+  waitForSave();
   disableWatcher();
 
   QString file = curFile;
@@ -475,6 +476,9 @@ void Gui::save()
 
   if (file.isEmpty()) {
     saveAs();
+  } else if (Preferences::modeGUI) {
+    saveFileInBackground(file);
+    return;   // the watcher is enabled when the save completes
   } else {
     saveFile(file);
   }
@@ -608,6 +612,7 @@ bool Gui::maybeSave(bool prompt, int sender /*SaveOnNone=0*/)
 
 bool Gui::saveFile(const QString &fileName)
 {
+  waitForSave();
   bool rc;
   rc = ldrawFile.saveFile(fileName);
   setCurrentFile(fileName);
@@ -618,9 +623,54 @@ bool Gui::saveFile(const QString &fileName)
   return rc;
 }
 
+// Write the model on a worker thread - the model contents are taken
+// when the save starts, so editing can continue while the file is written.
+// The document is marked saved when the write has succeeded.
+void Gui::saveFileInBackground(const QString &fileName)
+{
+  saveWatcherFile  = fileName;
+  saveWatcherIndex = undoStack->index();
+  saveWatcher.setFuture(ldrawFile.saveFileInBackground(fileName));
+}
+
+void Gui::saveFileFinished()
+{
+  // already handled by waitForSave
+  if (saveWatcherFile.isEmpty())
+    return;
+
+  const QString fileName = saveWatcherFile;
+  const QString error    = saveWatcher.result();
+  saveWatcherFile.clear();
+
+  if (error.isEmpty()) {
+    setCurrentFile(fileName);
+    // edits made while the file was written are not saved
+    if (undoStack->index() == saveWatcherIndex)
+      undoStack->setClean();
+    statusBar()->showMessage(tr("File %1 saved").arg(QFileInfo(fileName).fileName()), 2000);
+  } else {
+    emit messageSig(LOG_ERROR,error);
+  }
+
+  enableWatcher();
+}
+
+// Block until a background save has been written
+void Gui::waitForSave()
+{
+  if (!saveWatcherFile.isEmpty()) {
+    saveWatcher.waitForFinished();
+    saveFileFinished();
+  }
+}
+
 // This call performs LPub3D file close operations - does not clear curFile
 void Gui::closeFile()
 {
+  waitForSave();
+  ReleaseModelPieces();
+  Render::clearIncrementalRender();
   ldrawFile.empty();
   editWindow->textEdit()->document()->clear();
   editWindow->textEdit()->document()->setModified(false);
@@ -692,6 +742,7 @@ setWindowTitle(tr("%1[*] - %2").arg(windowName).arg(windowVersion));
 
 bool Gui::openFile(QString &fileName)
 {
+  waitForSave();
   disableWatcher();
 
   parsedMessages.clear();
@@ -742,6 +793,7 @@ bool Gui::openFile(QString &fileName)
   }
   insertFinalModel();    //insert final fully coloured model if fadeStep turned on
   generateCoverPages();  //auto-generate cover page
+  PreloadModelPieces();  //load referenced parts in the background
 
   enableWatcher();
 
@@ -124,13 +124,15 @@ public:
         ExportMode(-1 /*EXPORT_NONE*/),
         LineWidth(1.0),
         TransBackground(true),
-        HighlightNewParts(false)
+        HighlightNewParts(false),
+        IncrementalRender(false)
   { }
   NativeOptions()
       : ViewerOptions()
   {
     TransBackground   = true;
     HighlightNewParts = false;
+    IncrementalRender = false;
     LineWidth         = 1.0;
     ExportMode        = -1; //NONE
     IniFlag           = -1; //NONE
@@ -140,11 +142,13 @@ public:
   QString InputFileName;
   QString OutputFileName;
   QString ExportFileName;
+  QString IncrementKey;
   int IniFlag;
   int ExportMode;
   float LineWidth;
   bool TransBackground;
   bool HighlightNewParts;
+  bool IncrementalRender;
 };
 
 // Page Options Routines
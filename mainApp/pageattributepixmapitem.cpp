@@ -15,6 +15,7 @@
 #include <QAction>
 #include <QGraphicsRectItem>
 #include <QGraphicsSceneContextMenuEvent>
+#include <QFileInfo>
 
 #include "pageattributepixmapitem.h"
 #include "commonmenus.h"
@@ -22,6 +23,31 @@
 #include "step.h"
 #include "ranges.h"
 #include "name.h"
+#include "resolution.h"
+
+// cost is in KB - allow roughly 32 MB of decoded and composed pictures
+QCache<QString, QPixmap> PageAttributePixmapItem::pixmapCache(32 * 1024);
+
+bool PageAttributePixmapItem::loadPixmap(const QString &fileName, QPixmap &pixmap)
+{
+  QFileInfo fileInfo(fileName);
+  const QString key = QString("file|%1|%2")
+                              .arg(fileInfo.absoluteFilePath())
+                              .arg(fileInfo.lastModified().toMSecsSinceEpoch());
+
+  QPixmap *cached = pixmapCache.object(key);
+  if (cached) {
+    pixmap = *cached;
+    return true;
+  }
+
+  if (! pixmap.load(fileInfo.absoluteFilePath()))
+    return false;
+
+  int cost = qMax(1, pixmap.width() * pixmap.height() * pixmap.depth() / 8 / 1024);
+  pixmapCache.insert(key, new QPixmap(pixmap), cost);
+  return true;
+}
 
 PageAttributePixmapItem::PageAttributePixmapItem(
   Page                      *_page,
@@ -63,104 +89,121 @@ PageAttributePixmapItem::PageAttributePixmapItem(
     size[YY] = page->pageSize(YY,false,false);
   }
 
-  // create image from pixmap
-  QImage image(pixmap.toImage());
-  image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
-
-  if (fillMode != Aspect)
-      pixmap = pixmap.scaled(size[XX],size[YY]);
-  pixmap.fill(Qt::transparent);
-
-  // set painter and render hints (initialized with pixmap)
-  QPainter painter;
-  painter.begin(&pixmap);
-  painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
-  painter.setRenderHints(QPainter::Antialiasing,true);
-
-  // Set border
-  BorderData  borderData = pageAttributePictureMeta.border.valuePixels();
-
-  qreal rx = double(borderData.radius);
-  qreal ry = double(borderData.radius);
-  qreal dx = pixmap.width();
-  qreal dy = pixmap.height();
+  // pictures loaded through loadPixmap() share their cacheKey
+  const QString key = QString("picture|%1|%2|%3x%4|%5|%6")
+                              .arg(pixmap.cacheKey())
+                              .arg(fillMode)
+                              .arg(size[XX])
+                              .arg(size[YY])
+                              .arg(double(resolution()))
+                              .arg(border.format(false,false));
+
+  QPixmap *cached = pixmapCache.object(key);
+  if (cached) {
+    pixmap = *cached;
+  } else {
+    // create image from pixmap
+    QImage image(pixmap.toImage());
+    image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+    if (fillMode != Aspect)
+        pixmap = pixmap.scaled(size[XX],size[YY]);
+    pixmap.fill(Qt::transparent);
+
+    // set painter and render hints (initialized with pixmap)
+    QPainter painter;
+    painter.begin(&pixmap);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    painter.setRenderHints(QPainter::Antialiasing,true);
+
+    // Set border
+    BorderData  borderData = pageAttributePictureMeta.border.valuePixels();
+
+    qreal rx = double(borderData.radius);
+    qreal ry = double(borderData.radius);
+    qreal dx = pixmap.width();
+    qreal dy = pixmap.height();
+
+    if (dx > 0 && dy > 0) {
+      if (dx > dy) {
+        rx *= dy;
+        rx /= dx;
+      } else {
+        ry *= dx;
+        ry /= dy;
+      }
+    }
 
-  if (dx > 0 && dy > 0) {
-    if (dx > dy) {
-      rx *= dy;
-      rx /= dx;
+    QColor penColor;
+    QColor brushColor = Qt::transparent;
+    if (borderData.type == BorderData::BdrNone) {
+       penColor = Qt::transparent;
     } else {
-      ry *= dx;
-      ry /= dy;
+       penColor =  LDrawColor::color(borderData.color);
     }
-  }
 
-  QColor penColor;
-  QColor brushColor = Qt::transparent;
-  if (borderData.type == BorderData::BdrNone) {
-     penColor = Qt::transparent;
-  } else {
-     penColor =  LDrawColor::color(borderData.color);
-  }
+    QPen pen;
+    pen.setColor(penColor);
+    pen.setCapStyle(Qt::RoundCap);
+    pen.setJoinStyle(Qt::RoundJoin);
+    if (borderData.line == BorderData::BdrLnNone){
+      pen.setStyle(Qt::NoPen);
+    }
+    else if (borderData.line == BorderData::BdrLnSolid){
+      pen.setStyle(Qt::SolidLine);
+    }
+    else if (borderData.line == BorderData::BdrLnDash){
+      pen.setStyle(Qt::DashLine);
+    }
+    else if (borderData.line == BorderData::BdrLnDot){
+      pen.setStyle(Qt::DotLine);
+    }
+    else if (borderData.line == BorderData::BdrLnDashDot){
+      pen.setStyle(Qt::DashDotLine);
+    }
+    else if (borderData.line == BorderData::BdrLnDashDotDot){
+      pen.setStyle(Qt::DashDotDotLine);
+    }
 
-  QPen pen;
-  pen.setColor(penColor);
-  pen.setCapStyle(Qt::RoundCap);
-  pen.setJoinStyle(Qt::RoundJoin);
-  if (borderData.line == BorderData::BdrLnNone){
-    pen.setStyle(Qt::NoPen);
-  }
-  else if (borderData.line == BorderData::BdrLnSolid){
-    pen.setStyle(Qt::SolidLine);
-  }
-  else if (borderData.line == BorderData::BdrLnDash){
-    pen.setStyle(Qt::DashLine);
-  }
-  else if (borderData.line == BorderData::BdrLnDot){
-    pen.setStyle(Qt::DotLine);
-  }
-  else if (borderData.line == BorderData::BdrLnDashDot){
-    pen.setStyle(Qt::DashDotLine);
-  }
-  else if (borderData.line == BorderData::BdrLnDashDotDot){
-    pen.setStyle(Qt::DashDotDotLine);
-  }
+    int bt = int(borderData.thickness);
 
-  int bt = int(borderData.thickness);
+    QRectF prect(bt/2,bt/2,pixmap.width()-bt,pixmap.height()-bt);
 
-  QRectF prect(bt/2,bt/2,pixmap.width()-bt,pixmap.height()-bt);
+    pen.setWidth(bt);
 
-  pen.setWidth(bt);
+    painter.setPen(pen);
+    painter.setBrush(brushColor);
 
-  painter.setPen(pen);
-  painter.setBrush(brushColor);
+    if (borderData.type == BorderData::BdrRound) {
+      painter.drawRoundRect(prect,int(rx),int(ry));
+    } else {
+      painter.drawRect(prect);
+    }
 
-  if (borderData.type == BorderData::BdrRound) {
-    painter.drawRoundRect(prect,int(rx),int(ry));
-  } else {
-    painter.drawRect(prect);
-  }
+    // Adjust and draw image
+    if (fillMode == Stretch) {                                         // stretch
+        QSize psize = pixmap.size();
+        QSize isize = image.size();
+        qreal sx = psize.width();
+        qreal sy = psize.height();
+        sx /= isize.width();
+        sy /= isize.height();
+        painter.scale(sx,sy);
+        painter.drawImage(0,0,image);
+    } else if (fillMode == Tile) {                                    // tile
+        for (int y = 0; y < pixmap.height(); y += image.height()) {
+            for (int x = 0; x < pixmap.width(); x += image.width()) {
+                painter.drawImage(x,y,image);
+              }
+          }
+    } else {                                                          // aspect
+        painter.drawImage(0,0,image);
+    }
+    painter.end();
 
-  // Adjust and draw image
-  if (fillMode == Stretch) {                                         // stretch
-      QSize psize = pixmap.size();
-      QSize isize = image.size();
-      qreal sx = psize.width();
-      qreal sy = psize.height();
-      sx /= isize.width();
-      sy /= isize.height();
-      painter.scale(sx,sy);
-      painter.drawImage(0,0,image);
-  } else if (fillMode == Tile) {                                    // tile
-      for (int y = 0; y < pixmap.height(); y += image.height()) {
-          for (int x = 0; x < pixmap.width(); x += image.width()) {
-              painter.drawImage(x,y,image);
-            }
-        }
-  } else {                                                          // aspect
-      painter.drawImage(0,0,image);
+    int cost = qMax(1, pixmap.width() * pixmap.height() * pixmap.depth() / 8 / 1024);
+    pixmapCache.insert(key, new QPixmap(pixmap), cost);
   }
-  painter.end();
 
   setParentItem(parent);
   setPixmap(pixmap);
@@ -15,6 +15,7 @@
 #ifndef PAGEATTRIBUTEPIXMAPITEM_H
 #define PAGEATTRIBUTEPIXMAPITEM_H
 
+#include <QCache>
 #include <QGraphicsPixmapItem>
 #include "resize.h"
 
@@ -37,6 +38,12 @@ class PageAttributePixmapItem : public ResizePixmapItem
 
     virtual void change();
 
+    static bool loadPixmap(const QString &fileName, QPixmap &pixmap);
+    static void clearPixmapCache()
+    {
+      pixmapCache.clear();
+    }
+
 protected:
     void contextMenuEvent(QGraphicsSceneContextMenuEvent *event);
     void mousePressEvent(QGraphicsSceneMouseEvent *event);
@@ -47,6 +54,11 @@ protected:
     virtual void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget);
     bool isHovered;
     bool mouseIsDown;
+
+private:
+    // logos, cover and plug images repeat across pages so both the decoded
+    // file and the bordered/scaled result are kept for reuse
+    static QCache<QString, QPixmap> pixmapCache;
 };
 
 #endif // PAGEATTRIBUTEPIXMAPITEM_H
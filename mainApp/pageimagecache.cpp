@@ -0,0 +1,178 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public Liceense (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "pageimagecache.h"
+
+#include <QFileInfo>
+#include <QDateTime>
+#include <QImageReader>
+#include <QtConcurrent>
+
+QCache<QString, QPixmap>        PageImageCache::pixmaps(PAGE_IMAGE_CACHE_SIZE);
+QCache<QString, QImage>         PageImageCache::images(PAGE_IMAGE_DECODED_SIZE);
+QHash<QString, QFuture<QImage>> PageImageCache::pending;
+
+/*
+ * The file size is part of the key since a file rendered again within the
+ * modification time resolution of its file system keeps its time stamp.
+ */
+QString PageImageCache::cacheKey(const QString &fileName)
+{
+    const QFileInfo fileInfo(fileName);
+    return QString("%1|%2|%3")
+                   .arg(fileName)
+                   .arg(fileInfo.lastModified().toMSecsSinceEpoch())
+                   .arg(fileInfo.size());
+}
+
+int PageImageCache::cost(const QImage &image)
+{
+    return qMax(1, image.bytesPerLine() * image.height() / 1024);
+}
+
+QImage PageImageCache::decode(const QString &fileName)
+{
+    QImageReader reader(fileName);
+    QImage image;
+    if (! reader.read(&image))
+        return QImage();
+    return image;
+}
+
+/*
+ * Move finished prefetches into the decoded image cache. Stale keys
+ * (files rendered again since) and images never painted age out of it.
+ */
+void PageImageCache::collect()
+{
+    QHash<QString, QFuture<QImage>>::iterator it = pending.begin();
+    while (it != pending.end()) {
+        if (! it.value().isFinished()) {
+            ++it;
+            continue;
+        }
+        // unreadable files are kept as null images so ready() does not
+        // queue them again
+        const QImage image = it.value().result();
+        images.insert(it.key(), new QImage(image), cost(image));
+        it = pending.erase(it);
+    }
+}
+
+/*
+ * Return the pixmap for fileName, taking it from the cache, from a
+ * finished (or still running) prefetch, or decoding it now.
+ * A null pixmap is returned when the file cannot be read.
+ */
+QPixmap PageImageCache::pixmap(const QString &fileName)
+{
+    const QString key = cacheKey(fileName);
+
+    if (QPixmap *cached = pixmaps.object(key))
+        return *cached;
+
+    QImage image;
+    QHash<QString, QFuture<QImage>>::iterator it = pending.find(key);
+    if (QImage *decoded = images.object(key)) {
+        image = *decoded;
+        images.remove(key);
+    } else if (it != pending.end()) {
+        image = it.value().result();
+        pending.erase(it);
+    } else {
+        image = decode(fileName);
+    }
+
+    if (image.isNull())
+        return QPixmap();
+
+    QPixmap *pixmap = new QPixmap(QPixmap::fromImage(image));
+    const QPixmap result = *pixmap;
+    pixmaps.insert(key, pixmap, cost(image));
+
+    return result;
+}
+
+/*
+ * Add an image already decoded by the caller.
+ */
+void PageImageCache::insert(const QString &fileName, const QImage &image)
+{
+    if (image.isNull())
+        return;
+
+    const QString key = cacheKey(fileName);
+    pending.remove(key);
+    images.remove(key);
+    pixmaps.insert(key, new QPixmap(QPixmap::fromImage(image)), cost(image));
+}
+
+/*
+ * Add an image already decoded by the caller, leaving the pixmap
+ * conversion to its first use.
+ */
+void PageImageCache::insertImage(const QString &fileName, const QImage &image)
+{
+    if (image.isNull())
+        return;
+
+    const QString key = cacheKey(fileName);
+    if (pixmaps.contains(key))
+        return;
+    pending.remove(key);
+    images.insert(key, new QImage(image), cost(image));
+}
+
+/*
+ * Return true when pixmap() would not wait on a decode. Otherwise the
+ * image is queued for decoding, if it is not already.
+ */
+bool PageImageCache::ready(const QString &fileName)
+{
+    collect();
+
+    const QString key = cacheKey(fileName);
+    if (pixmaps.contains(key) || images.contains(key))
+        return true;
+
+    prefetch(QStringList() << fileName);
+
+    return false;
+}
+
+/*
+ * Queue images not yet cached for decoding on the thread pool.
+ */
+void PageImageCache::prefetch(const QStringList &fileNames)
+{
+    collect();
+
+    for (const QString &fileName : fileNames) {
+        if (fileName.isEmpty())
+            continue;
+        const QString key = cacheKey(fileName);
+        if (pixmaps.contains(key) || images.contains(key) || pending.contains(key))
+            continue;
+        pending.insert(key, QtConcurrent::run(&PageImageCache::decode, fileName));
+    }
+}
+
+void PageImageCache::clear()
+{
+    for (QFuture<QImage> &future : pending)
+        future.waitForFinished();
+    pending.clear();
+    images.clear();
+    pixmaps.clear();
+}
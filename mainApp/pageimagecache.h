@@ -0,0 +1,65 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public Liceense (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+/****************************************************************************
+ *
+ * This class keeps decoded page images (CSI, PLI part and submodel
+ * preview PNGs) in a size limited, least recently used cache keyed by
+ * file name, modification time and size, so revisiting a page does not decode
+ * its images again. Images can be queued for decoding on the global
+ * thread pool ahead of their first use. Finished decodes wait for their
+ * first use in a second size limited cache, so prefetched images that are
+ * never painted are dropped like any other cache entry.
+ *
+ * Pixmaps are only created on the GUI thread.
+ *
+ ***************************************************************************/
+
+#ifndef PAGEIMAGECACHE_H
+#define PAGEIMAGECACHE_H
+
+#include <QCache>
+#include <QFuture>
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QString>
+#include <QStringList>
+
+#define PAGE_IMAGE_CACHE_SIZE    262144 // pixmap budget in KB (256 MB)
+#define PAGE_IMAGE_DECODED_SIZE   65536 // budget in KB (64 MB) of decoded images not yet converted to pixmaps
+#define PAGE_IMAGE_POLL_INTERVAL     20 // ms between repaints of an item waiting on its decode
+
+class PageImageCache
+{
+  public:
+    static QPixmap pixmap(const QString &fileName);
+    static void insert(const QString &fileName, const QImage &image);
+    static void insertImage(const QString &fileName, const QImage &image);
+    static void prefetch(const QStringList &fileNames);
+    static bool ready(const QString &fileName);
+    static void clear();
+    static QString cacheKey(const QString &fileName);
+
+  private:
+    static QImage decode(const QString &fileName);
+    static int cost(const QImage &image);
+    static void collect();
+
+    static QCache<QString, QPixmap>        pixmaps;
+    static QCache<QString, QImage>         images;
+    static QHash<QString, QFuture<QImage>> pending;
+};
+
+#endif // PAGEIMAGECACHE_H
@@ -30,9 +30,32 @@
 #include "name.h"
 #include "lpub_preferences.h"
 
+QVector<ParmsHighlighter::HighlightingRule> ParmsHighlighter::highlightingRules;
+QTextCharFormat ParmsHighlighter::LPubVal1Format;
+QTextCharFormat ParmsHighlighter::LPubVal2Format;
+QTextCharFormat ParmsHighlighter::LPubVal3Format;
+QString ParmsHighlighter::highlightingTheme;
+
 ParmsHighlighter::ParmsHighlighter(QTextDocument *parent)
     : QSyntaxHighlighter(parent)
 {
+    // the rules are compiled once and shared by all editors
+    if (highlightingRules.isEmpty() || highlightingTheme != Preferences::displayTheme)
+        initHighlightingRules();
+
+    option = 0;
+}
+
+void ParmsHighlighter::initHighlightingRules()
+{
+    highlightingTheme = Preferences::displayTheme;
+    highlightingRules.clear();
+
+    QTextCharFormat LPubParmsCommentFormat;
+    QTextCharFormat LPubParmsHdrFormat;
+    QTextCharFormat LPubParmsEqualFormat;
+    QTextCharFormat LPubParmsValueFormat;
+
     HighlightingRule rule;
 
     QBrush br01; // Qt Dark green
@@ -71,28 +94,28 @@ ParmsHighlighter::ParmsHighlighter(QTextDocument *parent)
     // INI Header
     LPubParmsHdrFormat.setForeground(br02);
     LPubParmsHdrFormat.setFontWeight(QFont::Bold);
-    rule.pattern = QRegExp("^\\[.*[^\n]\\]$");
+    rule.pattern = QRegularExpression("^\\[.*[^\n]\\]$");
     rule.format = LPubParmsHdrFormat;
     highlightingRules.append(rule);
 
     // Right side value
     LPubParmsValueFormat.setForeground(br04);
     LPubParmsValueFormat.setFontWeight(QFont::Normal);
-    rule.pattern = QRegExp("\\=(.*)");
+    rule.pattern = QRegularExpression("\\=(.*)");
     rule.format = LPubParmsValueFormat;
     highlightingRules.append(rule);
 
     // Equal sign
     LPubParmsEqualFormat.setForeground(br03);
     LPubParmsEqualFormat.setFontWeight(QFont::Bold);
-    rule.pattern = QRegExp("=");
+    rule.pattern = QRegularExpression("=");
     rule.format = LPubParmsEqualFormat;
     highlightingRules.append(rule);
 
     // Comment
     LPubParmsCommentFormat.setForeground(br01);
     LPubParmsCommentFormat.setFontWeight(QFont::Normal);
-    rule.pattern = QRegExp("^[#|;][^\n]*");
+    rule.pattern = QRegularExpression("^[#|;][^\n]*");
     rule.format = LPubParmsCommentFormat;
     highlightingRules.append(rule);
 
@@ -101,7 +124,6 @@ ParmsHighlighter::ParmsHighlighter(QTextDocument *parent)
     // br05 - Part ID
     LPubVal1Format.setForeground(br05);
     LPubVal1Format.setFontWeight(QFont::Bold);
-    lineFormats.append(LPubVal1Format);
 
     // br06 - Part Control
     LPubVal2Format.setForeground(br06);
@@ -112,20 +134,17 @@ ParmsHighlighter::ParmsHighlighter(QTextDocument *parent)
     LPubVal3Format.setForeground(br07);
     LPubVal3Format.setFontWeight(QFont::Normal);
 
-    option = 0;
-
+    for (HighlightingRule &highlightingRule : highlightingRules)
+        highlightingRule.pattern.optimize();
 }
 
 void ParmsHighlighter::highlightBlock(const QString &text)
 {
-    foreach (HighlightingRule rule, highlightingRules) {
-        QRegExp expression(rule.pattern);
-
-        int index = text.indexOf(expression);
-        while (index >= 0) {
-            int length = expression.matchedLength();
-            setFormat(index, length, rule.format);
-            index = text.indexOf(expression, index + length);
+    for (const HighlightingRule &rule : highlightingRules) {
+        QRegularExpressionMatchIterator matches = rule.pattern.globalMatch(text);
+        while (matches.hasNext()) {
+            QRegularExpressionMatch match = matches.next();
+            setFormat(match.capturedStart(), match.capturedLength(), rule.format);
         }
     }
 
@@ -149,18 +168,21 @@ void ParmsHighlighter::highlightBlock(const QString &text)
     int index  = 0;
 
     QStringList tokens;
+    QList<QTextCharFormat> lineFormats;
+    lineFormats.append(LPubVal1Format);
+    QRegularExpressionMatch match;
 
     switch (option)
     {
     case 1:
     {
         // VER_PLI_SUBSTITUTE_PARTS_FILE
-        QRegExp rx1("^(\\b.+\\b)\\s+\"(.*)\"\\s+(.*)$");
-        if (text.contains(rx1)) {
+        static const QRegularExpression rx1("^(\\b.+\\b)\\s+\"(.*)\"\\s+(.*)$");
+        if ((match = rx1.match(text)).hasMatch()) {
             tokens
-            << rx1.cap(1).trimmed()
-            << "\""+rx1.cap(2).trimmed()+"\""
-            << rx1.cap(3).trimmed();
+            << match.captured(1).trimmed()
+            << "\""+match.captured(2).trimmed()+"\""
+            << match.captured(3).trimmed();
             lineFormats.append(LPubVal2Format);
             lineFormats.append(LPubVal3Format);
         }
@@ -169,11 +191,11 @@ void ParmsHighlighter::highlightBlock(const QString &text)
     case 2:
     {
         // VER_TITLE_ANNOTATIONS_FILE
-        QRegExp rx2("^(\\b.*[^\\s]\\b:)\\s+([\\(|\\^].*)$");
-        if (text.contains(rx2)) {
+        static const QRegularExpression rx2("^(\\b.*[^\\s]\\b:)\\s+([\\(|\\^].*)$");
+        if ((match = rx2.match(text)).hasMatch()) {
             tokens
-            << rx2.cap(1).trimmed()
-            << rx2.cap(2).trimmed();
+            << match.captured(1).trimmed()
+            << match.captured(2).trimmed();
             lineFormats.append(LPubVal3Format);
         }
     }
@@ -181,11 +203,11 @@ void ParmsHighlighter::highlightBlock(const QString &text)
     case 3:
     {
         // VER_FREEFOM_ANNOTATIONS_FILE
-        QRegExp rx3("^(\\b.*[^\\s]\\b)(?:\\s)\\s+(.*)$");
-        if (text.contains(rx3)) {
+        static const QRegularExpression rx3("^(\\b.*[^\\s]\\b)(?:\\s)\\s+(.*)$");
+        if ((match = rx3.match(text)).hasMatch()) {
             tokens
-            << rx3.cap(1).trimmed()
-            << rx3.cap(2).trimmed();
+            << match.captured(1).trimmed()
+            << match.captured(2).trimmed();
             lineFormats.append(LPubVal3Format);
         }
     }
@@ -193,11 +215,11 @@ void ParmsHighlighter::highlightBlock(const QString &text)
     case 4:
     {
         // VER_EXCLUDED_PARTS_FILE
-        QRegExp rx4("^(\\b.*[^\\s]\\b)(?:\\s)\\s+(.*)$");
-        if (text.contains(rx4)) {
+        static const QRegularExpression rx4("^(\\b.*[^\\s]\\b)(?:\\s)\\s+(.*)$");
+        if ((match = rx4.match(text)).hasMatch()) {
             tokens
-            << rx4.cap(1).trimmed()
-            << rx4.cap(2).trimmed();
+            << match.captured(1).trimmed()
+            << match.captured(2).trimmed();
             lineFormats.append(LPubVal3Format);
         }
     }
@@ -205,11 +227,11 @@ void ParmsHighlighter::highlightBlock(const QString &text)
     case 5:
     {
         // VER_STICKER_PARTS_FILE
-        QRegExp rx4("^(\\b.*[^\\s]\\b)(?:\\s)\\s+(.*)$");
-        if (text.contains(rx4)) {
+        static const QRegularExpression rx4("^(\\b.*[^\\s]\\b)(?:\\s)\\s+(.*)$");
+        if ((match = rx4.match(text)).hasMatch()) {
             tokens
-            << rx4.cap(1).trimmed()
-            << rx4.cap(2).trimmed();
+            << match.captured(1).trimmed()
+            << match.captured(2).trimmed();
             lineFormats.append(LPubVal3Format);
         }
     }
@@ -217,12 +239,12 @@ void ParmsHighlighter::highlightBlock(const QString &text)
     case 6:
     {
         // VER_LPUB3D_COLOR_PARTS
-        QRegExp rx5("^(\\b.*[^\\s]\\b)(?:\\s)\\s+(u|o)\\s+(.*)$");
-        if (text.contains(rx5)) {
+        static const QRegularExpression rx5("^(\\b.*[^\\s]\\b)(?:\\s)\\s+(u|o)\\s+(.*)$");
+        if ((match = rx5.match(text)).hasMatch()) {
             tokens
-            << rx5.cap(1).trimmed()
-            << rx5.cap(2).trimmed()
-            << rx5.cap(3).trimmed();
+            << match.captured(1).trimmed()
+            << match.captured(2).trimmed()
+            << match.captured(3).trimmed();
             lineFormats.append(LPubVal2Format);
             lineFormats.append(LPubVal3Format);
         }
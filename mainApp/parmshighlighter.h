@@ -31,6 +31,7 @@
 
 #include <QTextCharFormat>
 #include <QSyntaxHighlighter>
+#include <QRegularExpression>
 #include <QHash>
 
 class QTextDocument;
@@ -48,22 +49,20 @@ protected:
 private:
     struct HighlightingRule
     {
-        QRegExp pattern;
+        QRegularExpression pattern;
         QTextCharFormat format;
     };
 
-    QVector<HighlightingRule> highlightingRules;
+    static void initHighlightingRules();
 
-    QList<QTextCharFormat> lineFormats;
+    // shared by all instances, compiled once per theme
+    static QVector<HighlightingRule> highlightingRules;
 
-    QTextCharFormat LPubParmsCommentFormat;
-    QTextCharFormat LPubParmsHdrFormat;
-    QTextCharFormat LPubParmsEqualFormat;
-    QTextCharFormat LPubParmsValueFormat;
+    static QTextCharFormat LPubVal1Format;   // br05 Part ID
+    static QTextCharFormat LPubVal2Format;   // br06 Part Control
+    static QTextCharFormat LPubVal3Format;   // br07 Part Description
 
-    QTextCharFormat LPubVal1Format;   // br05 Part ID
-    QTextCharFormat LPubVal2Format;   // br06 Part Control
-    QTextCharFormat LPubVal3Format;   // br07 Part Description
+    static QString highlightingTheme;
 
     int option;
 
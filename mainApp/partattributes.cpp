@@ -0,0 +1,62 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public Liceense (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "partattributes.h"
+
+#include "excludedparts.h"
+#include "stickerparts.h"
+#include "ldrawcolourparts.h"
+#include "plisubstituteparts.h"
+#include "annotations.h"
+
+QHash<QString, PartAttributes> PartAttributes::attributes;
+QMutex                         PartAttributes::attributesMutex;
+int                            PartAttributes::generation = 0;
+
+PartAttributes PartAttributes::resolve(const QString &part)
+{
+    // keyed by the name as written so repeat lookups skip the lower case copy
+    QMutexLocker locker(&attributesMutex);
+    QHash<QString, PartAttributes>::const_iterator it = attributes.constFind(part);
+    if (it != attributes.constEnd())
+        return it.value();
+    const int recordGeneration = generation;
+    locker.unlock();
+
+    const QString name = part.toLower().trimmed();
+
+    PartAttributes record;
+    record.excluded           = ExcludedParts::hasExcludedPart(name);
+    record.sticker            = StickerParts::hasStickerPart(name);
+    record.colourPart         = LDrawColourParts::isLDrawColourPart(name);
+    record.substitute         = PliSubstituteParts::hasSubstitutePart(name);
+    record.annotationStyle    = Annotations::getAnnotationStyle(name);
+    record.annotationCategory = Annotations::getAnnotationCategory(name);
+    record.styleAnnotation    = Annotations::getStyleAnnotation(name);
+
+    // a clear() while the record was resolved may have come from reloaded
+    // lists - the record may be stale, so it is returned but not kept
+    locker.relock();
+    if (recordGeneration == generation)
+        attributes.insert(part, record);
+
+    return record;
+}
+
+void PartAttributes::clear()
+{
+    QMutexLocker locker(&attributesMutex);
+    attributes.clear();
+    generation++;
+}
@@ -0,0 +1,51 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public Liceense (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+/****************************************************************************
+ *
+ * This class resolves the parameter file lists (excluded, sticker, LDraw
+ * colour and PLI substitute parts, and annotation styles) for a part once
+ * and caches the result by part name. The cache is cleared whenever one
+ * of the source lists is (re)loaded.
+ *
+ ***************************************************************************/
+
+#ifndef PARTATTRIBUTES_H
+#define PARTATTRIBUTES_H
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+class PartAttributes
+{
+  public:
+    bool    excluded           = false;
+    bool    sticker            = false;
+    bool    colourPart         = false;
+    bool    substitute         = false;
+    int     annotationStyle    = 0;
+    int     annotationCategory = 0;
+    QString styleAnnotation;
+
+    static PartAttributes resolve(const QString &part);
+    static void clear();
+
+  private:
+    static QHash<QString, PartAttributes> attributes;
+    static QMutex                         attributesMutex;
+    static int                            generation;      // bumped by clear()
+};
+
+#endif // PARTATTRIBUTES_H
@@ -76,10 +76,10 @@ void Paths::mkDirs(){
 
     QDir dir;
     dir.mkdir(lpubDir);
-    dir.mkdir(tmpDir);
-    dir.mkdir(assemDir);
-    dir.mkdir(partsDir);
-    dir.mkdir(submodelDir);
+    dir.mkpath(tmpDir);
+    dir.mkpath(assemDir);
+    dir.mkpath(partsDir);
+    dir.mkpath(submodelDir);
 
 }
 
@@ -30,10 +30,15 @@
 #include <QMenu>
 #include <QGraphicsSceneContextMenuEvent>
 #include <QGraphicsRectItem>
+#include <QGraphicsScene>
 #include <QDir>
 #include <QFileInfo>
 #include <QFile>
 #include <QTextStream>
+#include <QDataStream>
+#include <QImageReader>
+#include <QTimer>
+#include <QtConcurrent>
 
 #include "lpub.h"
 #include "pli.h"
@@ -43,6 +48,7 @@
 #include "resolution.h"
 #include "render.h"
 #include "paths.h"
+#include "partattributes.h"
 #include "ldrawfiles.h"
 #include "placementdialog.h"
 #include "metaitem.h"
@@ -52,6 +58,8 @@
 #include "ranges_element.h"
 #include "range_element.h"
 #include "dependencies.h"
+#include "pageimagecache.h"
+#include "renderworkers.h"
 
 #include "lc_qglwidget.h"
 #include "lc_library.h"
@@ -59,6 +67,8 @@
 #include "previewwidget.h"
 
 QCache<QString,QString> Pli::orientation;
+QCache<QByteArray,Pli::PliLayout> Pli::layouts(1024);
+QCache<QString,PliPartImage> Pli::partImages(2048);
 
 QString PartTypeNames[NUM_PART_TYPES] = { "Fade Previous Steps", "Highlight Current Step", "Normal" };
 
@@ -384,13 +394,14 @@ void Pli::setParts(
                   if (fixedAnnotations) {
 
                       // get part annotation style flag for fixed annotations - cirle(1), square(2), or rectangle(3)
-                      AnnotationStyle fixedStyle = AnnotationStyle(Annotations::getAnnotationStyle(type));
+                      const PartAttributes partAttributes = PartAttributes::resolve(type);
+                      AnnotationStyle fixedStyle = AnnotationStyle(partAttributes.annotationStyle);
 
                       // set style meta settings
                       if (fixedStyle) {
                           // get style category
                           bool styleCategory = false;
-                          AnnotationCategory annotationCategory = AnnotationCategory(Annotations::getAnnotationCategory(type));
+                          AnnotationCategory annotationCategory = AnnotationCategory(partAttributes.annotationCategory);
                           switch (annotationCategory)
                           {
                           case AnnotationCategory::axle:
@@ -932,7 +943,7 @@ int Pli::createPartImage(QString  &nameKey /*old Value: partialKey*/,
     highlightStep = Preferences::enableHighlightStep && !gui->suppressColourMeta();
     bool fadePartOK = fadeSteps && !highlightStep && displayIcons;
     bool highlightPartOK = highlightStep && !fadeSteps && displayIcons;
-    bool isColorPart = gui->ldrawColourParts.isLDrawColourPart(type);
+    bool isColorPart = PartAttributes::resolve(type).colourPart;
     int stepNumber = step ? step->stepNumber.number : 0/*BOM page*/;
 
     // set key substitute flag when there is a name change
@@ -1187,40 +1198,35 @@ int Pli::createPartImagesLDViewSCall(QStringList &ldrNames, bool isNormalPart, i
     if (isNormalPart) {
 
         QString key;
+        QStringList imageNames;
+        foreach(key,parts.keys())
+            imageNames << parts[key]->imageName;
+        loadPartImages(imageNames);
+
         // 3. populate parts with image pixmap and size
         foreach(key,parts.keys()) {
 
             PliPart *part;
             // get part info
             part = parts[key];
-            // load image files into pixmap
-            // instantiate pixmps //ERROR
-            QPixmap *pixmap = new QPixmap();
-            if (pixmap == nullptr) {
-                rc = -1;
-                continue;
-            }
-
-            if (! pixmap->load(part->imageName)) {
+            // size the part from the cached image metrics - the
+            // pixmap itself is loaded when the item is first painted
+            PliPartImage partImage;
+            if (! loadPartImage(part->imageName, partImage)) {
                 emit gui->messageSig(LOG_ERROR,QMessageBox::tr("Could not load PLI pixmap image.<br>%1 was not found.")
                                      .arg(part->imageName));
                 rc = -1;
-                if (! pixmap->load(QString(":/resources/missingimage.png")))
+                if (! loadPartImage(QString(":/resources/missingimage.png"), partImage))
                     continue;
             }
 
-            // transfer image info to part
-            QImage image = pixmap->toImage();
-
-            part->pixmap = new PGraphicsPixmapItem(this,part,*pixmap,parentRelativeType,part->type, part->color);
-
-            delete pixmap;
+            part->pixmap = new PGraphicsPixmapItem(this,part,partImage,parentRelativeType,part->type, part->color);
 
             // size the PLI
-            part->pixmapWidth  = image.width();
-            part->pixmapHeight = image.height();
+            part->pixmapWidth  = partImage.width;
+            part->pixmapHeight = partImage.height;
 
-            part->width  = image.width();
+            part->width  = partImage.width;
 
             /* Add instance count area */
 
@@ -1252,7 +1258,7 @@ int Pli::createPartImagesLDViewSCall(QStringList &ldrNames, bool isNormalPart, i
             if (part->styleMeta.style.value() == AnnotationStyle::circle ||
                 part->styleMeta.style.value() == AnnotationStyle::square ||
                 part->styleMeta.style.value() == AnnotationStyle::rectangle)
-                descr = Annotations::getStyleAnnotation(part->type);
+                descr = PartAttributes::resolve(part->type).styleAnnotation;
             else
                 getAnnotation(part->type,descr,part->description);
 
@@ -1287,8 +1293,8 @@ int Pli::createPartImagesLDViewSCall(QStringList &ldrNames, bool isNormalPart, i
             }
 
             part->topMargin = part->csiMargin.valuePixels(YY);
-            getLeftEdge(image,part->leftEdge);
-            getRightEdge(image,part->rightEdge);
+            part->leftEdge  += partImage.leftEdge;
+            part->rightEdge += partImage.rightEdge;
 
             /*
              * Lets see if we can slide the text up in the bottom left corner of
@@ -1920,6 +1926,95 @@ void Pli::getRightEdge(
     }
 }
 
+/*
+ * Decode a part image and measure its size and edge profile. Safe to run
+ * on a worker thread - no pixmap is created. A null fileName in the
+ * returned metrics means the image could not be read.
+ */
+QPair<PliPartImage, QImage> Pli::scanPartImage(const QString &fileName)
+{
+  QPair<PliPartImage, QImage> result;
+  PliPartImage &partImage = result.first;
+  QImage       &image     = result.second;
+
+  QImageReader reader(fileName);
+  if (! reader.read(&image))
+      return QPair<PliPartImage, QImage>();
+
+  partImage.fileName  = fileName;
+  partImage.pixmapKey = PageImageCache::cacheKey(fileName);
+  partImage.width     = image.width();
+  partImage.height    = image.height();
+  getLeftEdge(image,partImage.leftEdge);
+  getRightEdge(image,partImage.rightEdge);
+
+  return result;
+}
+
+/*
+ * Measure the part images not yet in the metrics cache on the global
+ * thread pool. The decoded images go to the page image cache, where the
+ * pixmap conversion is left to the first paint.
+ */
+void Pli::loadPartImages(const QStringList &fileNames)
+{
+  QStringList scanNames;
+  for (const QString &fileName : fileNames) {
+      if (scanNames.contains(fileName))
+          continue;
+      PliPartImage *cached = partImages.object(fileName);
+      if (cached && cached->pixmapKey == PageImageCache::cacheKey(fileName))
+          continue;
+      scanNames << fileName;
+    }
+
+  if (scanNames.size() < 2)
+      return;
+
+  const QList<QPair<PliPartImage, QImage> > results =
+          QtConcurrent::blockingMapped<QList<QPair<PliPartImage, QImage> > >(scanNames, &Pli::scanPartImage);
+
+  for (const QPair<PliPartImage, QImage> &result : results) {
+      if (result.first.fileName.isEmpty())
+          continue;
+      PageImageCache::insertImage(result.first.fileName, result.second);
+      partImages.insert(result.first.fileName, new PliPartImage(result.first));
+    }
+}
+
+/*
+ * Fetch the size and edge profile of a part image. A changed file
+ * (new modification time or size) is decoded again. The decoded image is
+ * handed to the page image cache so the first paint does not reload it.
+ */
+bool Pli::loadPartImage(
+    const QString &fileName,
+    PliPartImage  &partImage)
+{
+  const QString pixmapKey = PageImageCache::cacheKey(fileName);
+
+  if (PliPartImage *cached = partImages.object(fileName)) {
+      if (cached->pixmapKey == pixmapKey) {
+          partImage = *cached;
+          return true;
+        }
+    }
+
+  const QPair<PliPartImage, QImage> result = scanPartImage(fileName);
+  if (result.first.fileName.isEmpty()) {
+      partImage = PliPartImage();
+      return false;
+    }
+
+  partImage = result.first;
+
+  PageImageCache::insertImage(fileName, result.second);
+
+  partImages.insert(fileName, new PliPartImage(partImage));
+
+  return true;
+}
+
 bool Pli::loadTheViewer(){
     if (! gui->exporting()) {
         if (! renderer->LoadViewer(viewerOptions)) {
@@ -2085,6 +2180,12 @@ int Pli::partSize()
       widestPart = 0;
       tallestPart = 0;
 
+      // create the part images first so the Native renders queued
+      // by createPartImage can run together on the render workers
+      QHash<QString, QString> partImageNames;
+
+      RenderWorkers::beginBatch();
+
       foreach(key,parts.keys()) {
           PliPart *part;
 
@@ -2101,26 +2202,39 @@ int Pli::partSize()
                   part->color = "0";
                 }
 
-              QPixmap *pixmap = new QPixmap();
-              if (pixmap == nullptr) {
-                  return -1;
-                }
-
-              if (createPartImage(part->nameKey,part->type,part->color,pixmap,part->subType)) {
+              if (createPartImage(part->nameKey,part->type,part->color,nullptr,part->subType)) {
                   emit gui->messageSig(LOG_ERROR, QMessageBox::tr("Failed to create PLI part for key %1")
                                        .arg(part->nameKey));
               }
 
-              QImage image = pixmap->toImage();
+              partImageNames.insert(key, imageName);
+            }
+        }
+
+      RenderWorkers::endBatch();
+
+      loadPartImages(partImageNames.values());
+
+      foreach(key,parts.keys()) {
+          PliPart *part;
+
+          part = parts[key];
+
+          if (partImageNames.contains(key)) {
 
-              part->pixmap = new PGraphicsPixmapItem(this,part,*pixmap,parentRelativeType,part->type, part->color);
+              // size the part from the cached image metrics - the
+              // pixmap itself is loaded when the item is first painted
+              PliPartImage partImage;
+              if (! loadPartImage(partImageNames.value(key), partImage)) {
+                  loadPartImage(QString(":/resources/missingimage.png"), partImage);
+                }
 
-              delete pixmap;
+              part->pixmap = new PGraphicsPixmapItem(this,part,partImage,parentRelativeType,part->type, part->color);
 
-              part->pixmapWidth  = image.width();
-              part->pixmapHeight = image.height();
+              part->pixmapWidth  = partImage.width;
+              part->pixmapHeight = partImage.height;
 
-              part->width  = image.width();
+              part->width  = partImage.width;
 
               /* Add instance count area */
 
@@ -2152,7 +2266,7 @@ int Pli::partSize()
               if (part->styleMeta.style.value() == AnnotationStyle::circle ||
                   part->styleMeta.style.value() == AnnotationStyle::square ||
                   part->styleMeta.style.value() == AnnotationStyle::rectangle)
-                  descr = Annotations::getStyleAnnotation(part->type);
+                  descr = PartAttributes::resolve(part->type).styleAnnotation;
               else
                   getAnnotation(part->type,descr,part->description);
 
@@ -2187,8 +2301,8 @@ int Pli::partSize()
                 }
 
               part->topMargin = part->csiMargin.valuePixels(YY);
-              getLeftEdge(image,part->leftEdge);
-              getRightEdge(image,part->rightEdge);
+              part->leftEdge  += partImage.leftEdge;
+              part->rightEdge += partImage.rightEdge;
 
               /*
                * Lets see if we can slide the text up in the bottom left corner of
@@ -2330,7 +2444,7 @@ int Pli::partSizeLDViewSCall() {
                 pliPart->color = "0";
             }
 
-            bool isColorPart = gui->ldrawColourParts.isLDrawColourPart(pliPart->type);
+            bool isColorPart = PartAttributes::resolve(pliPart->type).colourPart;
 
             QString nameKey = pliPart->nameKey;
 
@@ -2466,7 +2580,7 @@ int Pli::partSizeLDViewSCall() {
                     // define ldr file name
                     QFileInfo typeInfo = QFileInfo(pliPart->type);
                     QString typeName = typeInfo.fileName();
-                    bool isColorPart = gui->ldrawColourParts.isLDrawColourPart(typeInfo.fileName());
+                    bool isColorPart = PartAttributes::resolve(typeName).colourPart;
                     if (pT != NORMAL_PART && (isSubModel || isColorPart))
                         typeName = typeInfo.completeBaseName() + ptn[pT].typeName + "." + typeInfo.suffix();
 
@@ -2654,6 +2768,48 @@ int Pli::sizePli(ConstrainData::PliConstrain constrain, unsigned height)
   return 1;
 }
 
+/*
+ * Everything placePli and placeCols read from the parts and the PLI
+ * metas, in sorted key order. Part edges are reduced to hashes.
+ */
+QByteArray Pli::layoutKey(const ConstrainData &constrainData)
+{
+  QByteArray key;
+  QDataStream stream(&key, QIODevice::WriteOnly);
+
+  BorderData borderData = pliMeta.border.valuePixels();
+
+  stream << int(constrainData.type)
+         << constrainData.constraint
+         << pliMeta.pack.value()
+         << pliMeta.sort.value()
+         << bom
+         << pliMeta.partElements.display.value()
+         << borderData.thickness
+         << borderData.margin[0]
+         << borderData.margin[1]
+         << int(toPixels(0.1f,DPI))
+         << sortedKeys.size();
+
+  for (int i = 0; i < sortedKeys.size(); i++) {
+      PliPart *part = parts[sortedKeys[i]];
+      stream << part->width
+             << part->height
+             << part->topMargin
+             << part->annotWidth
+             << part->csiMargin.valuePixels(XX)
+             << part->csiMargin.valuePixels(YY)
+             << part->instanceMeta.margin.valuePixels(XX)
+             << part->styleMeta.margin.valuePixels(XX)
+             << int(part->styleMeta.style.value())
+             << part->leftEdge.size()
+             << qHashRange(part->leftEdge.begin(), part->leftEdge.end())
+             << qHashRange(part->rightEdge.begin(), part->rightEdge.end(), 1);
+    }
+
+  return key;
+}
+
 int Pli::resizePli(
     Meta *meta,
     ConstrainData &constrainData)
@@ -2671,6 +2827,24 @@ int Pli::resizePli(
       break;
     }
 
+  // Reuse the packing from an earlier pass with the same inputs
+
+  const QByteArray key = layoutKey(constrainData);
+
+  if (PliLayout *layout = layouts.object(key)) {
+      for (int i = 0; i < sortedKeys.size(); i++) {
+          PliPart *part = parts[sortedKeys[i]];
+          part->left   = layout->parts[i].left;
+          part->bot    = layout->parts[i].bot;
+          part->col    = layout->parts[i].col;
+          part->placed = layout->parts[i].placed;
+        }
+      constrainData.type = ConstrainData::PliConstrain(layout->constrainType);
+      size[0] = layout->size[0];
+      size[1] = layout->size[1];
+      return 0;
+    }
+
   // Fill the part list image using constraint
   //   Constrain Height
   //   Constrain Width
@@ -2878,6 +3052,17 @@ int Pli::resizePli(
   size[0] = pliWidth;
   size[1] = pliHeight;
 
+  PliLayout *layout = new PliLayout;
+  layout->parts.reserve(sortedKeys.size());
+  for (int i = 0; i < sortedKeys.size(); i++) {
+      PliPart *part = parts[sortedKeys[i]];
+      layout->parts.append({ part->left, part->bot, part->col, part->placed });
+    }
+  layout->size[0] = size[0];
+  layout->size[1] = size[1];
+  layout->constrainType = int(constrainData.type);
+  layouts.insert(key, layout);
+
   return 0;
 }
 
@@ -3552,6 +3737,66 @@ PGraphicsPixmapItem::PGraphicsPixmapItem(
   setZValue(PARTSLISTPARTPIXMAP_ZVALUE_DEFAULT);
 }
 
+PGraphicsPixmapItem::PGraphicsPixmapItem(
+  Pli     *_pli,
+  PliPart *_part,
+  const PliPartImage &partImage,
+  PlacementType _parentRelativeType,
+  QString &type,
+  QString &color) :
+    imageFile(partImage.fileName),
+    imageSize(partImage.width, partImage.height),
+    pixmapLoaded(false),
+    isHovered(false),
+    mouseIsDown(false)
+{
+  parentRelativeType = _parentRelativeType;
+  pli = _pli;
+  part = _part;
+  bool isSub = _part->subType;
+
+  // decode off the GUI thread unless the pixmap is still cached
+  PageImageCache::prefetch(QStringList() << imageFile);
+
+  setFlag(QGraphicsItem::ItemIsSelectable,true);
+  setFlag(QGraphicsItem::ItemIsFocusable, true);
+  setAcceptHoverEvents(true);
+  setToolTip(pliToolTip(type,color,isSub));
+  setData(ObjectId, PartsListPixmapObj);
+  setZValue(PARTSLISTPARTPIXMAP_ZVALUE_DEFAULT);
+}
+
+void PGraphicsPixmapItem::loadPixmap()
+{
+  if (pixmapLoaded)
+    return;
+  pixmapLoaded = true;
+
+  QPixmap pixmap = PageImageCache::pixmap(imageFile);
+  if (pixmap.isNull() && ! imageFile.isEmpty())
+      pixmap.load(QString(":/resources/missingimage.png"));
+
+  prepareGeometryChange();
+  setPixmap(pixmap);
+}
+
+QRectF PGraphicsPixmapItem::boundingRect() const
+{
+  if (! pixmapLoaded)
+    return QRectF(offset(), QSizeF(imageSize));
+  return QGraphicsPixmapItem::boundingRect();
+}
+
+QPainterPath PGraphicsPixmapItem::shape() const
+{
+  if (! pixmapLoaded) {
+    QPainterPath path;
+    path.addRect(boundingRect());
+    return path;
+  }
+  return QGraphicsPixmapItem::shape();
+}
+
 void PGraphicsPixmapItem::previewPart() {
     int colorCode        = part->color.toInt();
     QString partType     = part->type;
@@ -3679,6 +3924,18 @@ void PGraphicsPixmapItem::mouseReleaseEvent(QGraphicsSceneMouseEvent *event)
 
 void PGraphicsPixmapItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
+    // do not wait on the decode in the viewer - draw the frame and
+    // repaint once it is done. Exported pages must be complete.
+    if (! pixmapLoaded && ! gui->exporting() && ! PageImageCache::ready(imageFile)) {
+        if (QGraphicsScene *itemScene = scene()) {
+            const QRectF rect = sceneBoundingRect();
+            QTimer::singleShot(PAGE_IMAGE_POLL_INTERVAL, itemScene, [itemScene, rect] { itemScene->update(rect); });
+        } else {
+            loadPixmap();
+        }
+    } else {
+        loadPixmap();
+    }
     QPen pen;
     pen.setColor(isHovered ? QColor(Preferences::sceneGuideColor) : Qt::black);
     pen.setWidth(0/*cosmetic*/);
@@ -40,6 +40,8 @@
 #include <QList>
 #include <QHash>
 #include <QCache>
+#include <QVector>
+#include <QImage>
 #include <QTextDocument>
 
 #include "meta.h"
@@ -63,6 +65,20 @@ class InstanceTextItem;
 class AnnotateTextItem;
 class PGraphicsPixmapItem;
 class PliBackgroundItem;
+
+/*
+ * Size and edge profile of a rendered PLI part image, cached per file
+ * and modification time so part sizing does not decode the image again.
+ */
+struct PliPartImage
+{
+  QString    fileName;
+  QString    pixmapKey;
+  int        width  = 0;
+  int        height = 0;
+  QList<int> leftEdge;
+  QList<int> rightEdge;
+};
 class PartGroupItem;
 class LGraphicsScene;
 
@@ -164,6 +180,26 @@ class Pli : public Placement {
   private:
     static QCache<QString, QString> orientation;
 
+    // packed part positions, reused while the part sizes,
+    // margins and constraint are unchanged
+    struct PliLayoutPart
+    {
+      int  left;
+      int  bot;
+      int  col;
+      bool placed;
+    };
+    struct PliLayout
+    {
+      QVector<PliLayoutPart> parts;
+      int                    size[2];
+      int                    constrainType;
+    };
+    static QCache<QByteArray, PliLayout> layouts;
+    QByteArray layoutKey(const ConstrainData &constrainData);
+
+    static QCache<QString, PliPartImage> partImages;
+
     QHash<QString, PliPart*> tempParts;          // temp list used to devide the BOM
     QHash<QString, PliPart*> parts;
     QList<QString>           sortedKeys;
@@ -296,8 +332,11 @@ class Pli : public Placement {
       _parts = parts;
     }
 
-    void getLeftEdge(QImage &, QList<int> &);
-    void getRightEdge(QImage &, QList<int> &);
+    static void getLeftEdge(QImage &, QList<int> &);
+    static void getRightEdge(QImage &, QList<int> &);
+    static QPair<PliPartImage, QImage> scanPartImage(const QString &fileName);
+    void loadPartImages(const QStringList &fileNames);
+    bool loadPartImage(const QString &fileName, PliPartImage &partImage);
 };
 
 class PliBackgroundItem : public BackgroundItem, public AbstractResize, public Placement
@@ -365,12 +404,25 @@ public:
             PlacementType  _parentRelativeType,
             QString &type,
             QString &color);
+    PGraphicsPixmapItem(
+            Pli     *_pli,
+            PliPart *_part,
+            const PliPartImage &partImage,
+            PlacementType  _parentRelativeType,
+            QString &type,
+            QString &color);
     QString pliToolTip(QString type, QString Color,bool isSub = false);
     void previewPart();
+    QRectF boundingRect() const override;
+    QPainterPath shape() const override;
     PliPart *part;
     Pli     *pli;
     PlacementType  parentRelativeType;
 protected:
+    void loadPixmap();
+    QString        imageFile;
+    QSize          imageSize;
+    bool           pixmapLoaded = true;
     virtual void contextMenuEvent(QGraphicsSceneContextMenuEvent *event);
     virtual void hoverEnterEvent(QGraphicsSceneHoverEvent* event);
     virtual void hoverLeaveEvent(QGraphicsSceneHoverEvent* event);
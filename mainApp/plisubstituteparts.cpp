@@ -22,6 +22,7 @@
 #include "name.h"
 #include "version.h"
 #include "lpub_preferences.h"
+#include "partattributes.h"
 #include "QsLog.h"
 
 bool                    PliSubstituteParts::result;
@@ -81,6 +82,7 @@ PliSubstituteParts::PliSubstituteParts()
                 }
             }
         }
+        PartAttributes::clear();
     }
 }
 
@@ -720,6 +720,8 @@ void Gui::exportAsPdf()
   // store current display page number
   int savePageNumber = displayPageNum;
 
+  Render::clearRenderFailures();
+
   // add pixel ratio info to file name
   QString dpiInfo = QString("_%1_DPI").arg(int(resolution()));
   if (exportPixelRatio > 1.0 || exportPixelRatio < 1.0){
@@ -824,6 +826,17 @@ void Gui::exportAsPdf()
   int _displayPageNum = 0;
   int _maxPages       = 0;
 
+  // command line export split across worker processes - the workers
+  // return page images so only a raster pdf can be merged from them
+  QMap<int, QString> shardImages;
+  bool exportShards = false;
+  if (!Preferences::modeGUI && exportWorkers > 1) {
+      if (exportPdfElements)
+          emit messageSig(LOG_NOTICE,QString("Pdf export workers require pdf page images. Exporting vector pdf in process."));
+      else
+          exportShards = exportAsPdfShards(baseName, shardImages);
+  }
+
   // initialize progress bar dialog
   m_progressDialog->setWindowTitle("Export pdf");
   if (Preferences::modeGUI)
@@ -844,6 +857,45 @@ void Gui::exportAsPdf()
 
   m_progressDlgMessageLbl->setText("Exporting instructions to pdf...");
 
+  if (exportShards) {
+
+      m_progressDlgProgressBar->setRange(1,shardImages.count());
+
+      int _pageCount = 0;
+
+      // paint the worker page images to the pdfWriter in page order
+      QPainter painter;
+      foreach (int printPage, shardImages.keys()) {
+
+          displayPageNum = printPage;
+
+          m_progressDlgMessageLbl->setText(QString("Merging pdf document page %1 (%2 of %3)...")
+                                           .arg(displayPageNum)
+                                           .arg(_pageCount + 1)
+                                           .arg(shardImages.count()));
+          m_progressDlgProgressBar->setValue(_pageCount + 1);
+
+          pdfWriter.setPageLayout(getPageLayout());
+          if (_pageCount++)
+              pdfWriter.newPage();
+          else
+              painter.begin(&pdfWriter);
+
+          getExportPageSize(pageWidthIn, pageHeightIn, Inches);
+          painter.drawImage(QRect(0,0,
+                                  int(pdfWriter.logicalDpiX()*pageWidthIn),
+                                  int(pdfWriter.logicalDpiY()*pageHeightIn)),
+                                  QImage(shardImages[printPage]));
+      }
+
+      m_progressDlgProgressBar->setValue(shardImages.count());
+
+      // wrap up paint to pdfWriter
+      painter.end();
+
+      QDir(QFileInfo(shardImages.first()).absolutePath()).removeRecursively();
+
+    } else
   if (processOption != EXPORT_PAGE_RANGE) {
 
       if(processOption == EXPORT_ALL_PAGES){
@@ -1218,6 +1270,8 @@ void Gui::exportAsPdf()
   displayPageNum = savePageNumber;
   drawPage(KpageView,KpageScene,false);
 
+  Render::reportRenderFailures();
+
   //display completion message
   QPixmap _icon = QPixmap(":/icons/lpub96.png");
   box.setWindowIcon(QIcon());
@@ -1257,11 +1311,143 @@ void Gui::exportAsPdf()
     }
 }
 
+/*
+ * Split the pdf page range into contiguous shards and export each shard to
+ * png page images with a headless LPub3D worker process. Each worker uses
+ * its own temp directory and image caches, kept between exports so later
+ * exports find them warm. The caches are cleared with the -x argument,
+ * which is passed on to the workers, and by this process' cache resets,
+ * which also remove the worker folders. On success
+ * pageImages holds the page image file for every page in the range, in
+ * page order; on failure nothing is returned and the caller exports in
+ * process.
+ */
+bool Gui::exportAsPdfShards(const QString &baseName, QMap<int, QString> &pageImages)
+{
+  QList<int> printPages;
+  if (processOption == EXPORT_PAGE_RANGE) {
+      foreach(QString ranges,pageRangeText.split(",")){
+          if (ranges.contains("-")){
+              QStringList range = ranges.split("-");
+              int minPage = range[0].toInt();
+              int maxPage = range[1].toInt();
+              for(int i = minPage; i <= maxPage; i++){
+                  printPages.append(i);
+                }
+            } else {
+              printPages.append(ranges.toInt());
+            }
+        }
+      std::sort(printPages.begin(),printPages.end(),lessThan);
+  } else {
+      for (int i = 1; i <= maxPages; i++)
+          printPages.append(i);
+  }
+
+  int workers = qMin(exportWorkers, printPages.size());
+  if (workers < 2)
+      return false;
+
+  QString shardDir = QDir::currentPath() + QDir::separator() + Paths::tmpDir + QDir::separator() + "pdfshards";
+  QDir(shardDir).removeRecursively();
+  if (!QDir().mkpath(shardDir)) {
+      emit messageSig(LOG_ERROR,QString("Could not create pdf export worker folder %1.").arg(shardDir));
+      return false;
+  }
+
+  // worker arguments are our own, less those each shard replaces
+  QStringList arguments;
+  const QStringList commandArguments = QCoreApplication::arguments();
+  for (int i = 1; i < commandArguments.size(); i++) {
+      const QString &Param = commandArguments[i];
+      if (Param == QLatin1String("-o")  || Param == QLatin1String("--export-option")          ||
+          Param == QLatin1String("-of") || Param == QLatin1String("--pdf-output-file")        ||
+          Param == QLatin1String("-d")  || Param == QLatin1String("--image-output-directory") ||
+          Param == QLatin1String("-r")  || Param == QLatin1String("--range")                  ||
+          Param == QLatin1String("-ew") || Param == QLatin1String("--export-workers")) {
+          if (i < commandArguments.size() - 1 && !commandArguments[i + 1].startsWith('-'))
+              i++;
+          continue;
+      }
+      // -x is kept to reset the workers' own caches
+      if (Param == QLatin1String("-pf") || Param == QLatin1String("--process-file")  ||
+          Param == QLatin1String("-pe") || Param == QLatin1String("--process-export"))
+          continue;
+      arguments << Param;
+  }
+
+  QElapsedTimer shardTimer;
+  shardTimer.start();
+
+  QList<QProcess *> processes;
+  int shardSize = (printPages.size() + workers - 1) / workers;
+  for (int shard = 0; shard < workers; shard++) {
+      QStringList shardPages;
+      for (int i = shard * shardSize; i < qMin((shard + 1) * shardSize, printPages.size()); i++)
+          shardPages << QString::number(printPages.at(i));
+      if (shardPages.isEmpty())
+          break;
+
+      QStringList shardArguments = arguments;
+      shardArguments << "-pe" << "-o" << "png"
+                     << "-r" << shardPages.join(",")
+                     << "-d" << shardDir
+                     << "--export-shard" << QString::number(shard + 1)
+                     << QFileInfo(curFile).absoluteFilePath(); // last file argument wins
+
+      QProcess *process = new QProcess(this);
+      process->setWorkingDirectory(QDir::currentPath());
+      process->setStandardOutputFile(QString("%1/shard_%2.log").arg(shardDir).arg(shard + 1));
+      process->setStandardErrorFile(QString("%1/shard_%2.log").arg(shardDir).arg(shard + 1), QIODevice::Append);
+      process->start(QCoreApplication::applicationFilePath(), shardArguments);
+      processes.append(process);
+
+      emit messageSig(LOG_INFO,QString("Pdf export worker %1 started for pages %2-%3.")
+                      .arg(shard + 1).arg(shardPages.first()).arg(shardPages.last()));
+  }
+
+  bool ok = true;
+  for (int shard = 0; shard < processes.size(); shard++) {
+      QProcess *process = processes.at(shard);
+      if (!process->waitForStarted() || !process->waitForFinished(-1) ||
+           process->exitStatus() != QProcess::NormalExit || process->exitCode() != 0) {
+          emit messageSig(LOG_ERROR,QString("Pdf export worker %1 failed: %2. See %3/shard_%1.log.")
+                          .arg(shard + 1).arg(process->errorString()).arg(shardDir));
+          ok = false;
+      }
+      delete process;
+  }
+
+  if (ok) {
+      foreach (int printPage, printPages) {
+          QString imageFile = QString("%1/%2_page_%3.png").arg(shardDir).arg(baseName).arg(printPage);
+          if (!QFileInfo(imageFile).exists()) {
+              emit messageSig(LOG_ERROR,QString("Pdf export worker image for page %1 not found.").arg(printPage));
+              ok = false;
+              break;
+          }
+          pageImages.insert(printPage, imageFile);
+      }
+  }
+
+  if (!ok) {
+      pageImages.clear();
+      emit messageSig(LOG_INFO,QString("Pdf export workers failed. Exporting in process."));
+      return false;
+  }
+
+  emit messageSig(LOG_INFO,QString("Pdf export workers generated %1 pages. %2.")
+                  .arg(pageImages.size()).arg(elapsedTime(shardTimer.elapsed())));
+  return true;
+}
+
 void Gui::exportAs(const QString &_suffix)
 {
   QString suffix = _suffix;
   QString directoryName = QDir::currentPath();
 
+  Render::clearRenderFailures();
+
   QString type;
   if (suffix == ".png" ||
       suffix == ".jpg" ||
@@ -1327,6 +1513,9 @@ void Gui::exportAs(const QString &_suffix)
   } else
     if (!saveDirectoryName.isEmpty()) {
       directoryName = saveDirectoryName;
+  } else
+    if (!Preferences::modeGUI && !saveFileName.isEmpty()) { // command line user specified directory
+      directoryName = saveFileName;
   }
 
   LGraphicsScene scene;
@@ -1583,6 +1772,8 @@ void Gui::exportAs(const QString &_suffix)
   displayPageNum = savePageNumber;
   drawPage(KpageView,KpageScene,false);
 
+  Render::reportRenderFailures();
+
   //display completion message
   QPixmap _icon = QPixmap(":/icons/lpub96.png");
   QMessageBoxResizable box;
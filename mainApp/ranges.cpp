@@ -36,6 +36,7 @@
 #include "callout.h"
 #include "lpub.h"
 #include "dividerdialog.h"
+#include "partattributes.h"
 
 #include "render.h"
 #include "resize.h"
@@ -820,16 +821,15 @@ void Steps::setCsiAnnotationMetas(bool force)
 
                   if (part->annotateText) {
                     QString typeName = QFileInfo(part->type).completeBaseName();
-                    QString pattern = QString("^\\s*0\\s+(\\!*LPUB ASSEM ANNOTATION ICON).*("+typeName+"|HIDDEN|HIDE).*$");
-                    QRegExp rx(pattern);
                     Where nextLine = walk;
                     line = gui->readLine(++nextLine); // check next line - skip if meta exist [we may have to extend this check to the end of the Step]
-                    if ((line.contains(rx) && typeName == rx.cap(2)) ||
-                       ((rx.cap(2) == "HIDDEN" || rx.cap(2) == "HIDE") && !force))
+                    Step::CsiAnnotationIcon icon = Step::csiAnnotationIcon(line, typeName);
+                    if (icon == Step::PartAnnotationIcon ||
+                       (icon == Step::HiddenAnnotationIcon && !force))
                        continue;
 
                     bool display = false;
-                    AnnotationCategory annotationCategory = AnnotationCategory(Annotations::getAnnotationCategory(part->type));
+                    AnnotationCategory annotationCategory = AnnotationCategory(PartAttributes::resolve(part->type).annotationCategory);
                     switch (annotationCategory)
                     {
                     case AnnotationCategory::axle:
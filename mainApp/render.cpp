@@ -34,6 +34,7 @@
 #include <QDir>
 #include <QTextStream>
 #include <QImageReader>
+#include <QElapsedTimer>
 #include <QtConcurrent>
 
 #include "lpub.h"
@@ -43,6 +44,7 @@
 #include "math.h"
 #include "lpub_preferences.h"
 #include "application.h"
+#include "renderworkers.h"
 
 #include <LDVQt/LDVWidget.h>
 #include <LDVQt/LDVImageMatte.h>
@@ -58,6 +60,9 @@
 #include "lc_partselectionwidget.h"
 
 #include "lc_library.h"
+#include "lc_colors.h"
+#include "lc_qutils.h"
+#include "lc_profile.h"
 
 #ifdef Q_OS_WIN
 #include <Windows.h>
@@ -83,6 +88,81 @@ static double pi = 4*atan(1.0);
 // the default camera distance for real size
 static float LduDistance = float(10.0/tan(0.005*pi/180));
 
+// the previous Native CSI render - consecutive steps that only add parts
+// are drawn over the retained framebuffer of the previous step
+struct NativeIncrement
+{
+    QString     Key;       // camera, image size and render settings
+    QStringList Geometry;  // main model geometry lines
+    QStringList Meta;      // all other lines, including submodel sections
+    QString     InputFileName; // the complete step file of an incremental render
+    std::pair<lcFramebuffer, lcFramebuffer> Framebuffer;
+    bool        Valid = false;
+};
+static NativeIncrement nativeIncrement;
+static QSet<QString> nativeIncrementVerified;  // keys whose incremental render matched the full render
+static QSet<QString> nativeIncrementMismatch;  // keys whose incremental render did not
+
+// shortcut renders (incremental CSI, recoloured PLI) are checked against
+// a direct render of the same image with these bounds
+#define NATIVE_IMAGE_TOLERANCE 24 // largest channel difference of a matching pixel
+#define NATIVE_IMAGE_MISMATCH  10 // mismatching pixels allowed per thousand
+
+// Native PLI part renders in a light and a dark main colour - the shading
+// they share lets other colours of the same part be composited directly
+struct NativeColorLayers
+{
+    QImage Light;
+    QImage Dark;
+};
+static QCache<QString, NativeColorLayers> nativeColorLayers(64 * 1024);
+static QSet<QString> nativeFixedColorParts;
+
+// the first colour of a part is rendered directly - its image checks the
+// layers composite once a second colour of the part is requested
+struct NativeColorFirst
+{
+    int     ColorIndex;
+    QString FileName;
+};
+static QHash<QString, NativeColorFirst> nativeColorFirst;
+
+
+// camera, image size and render settings of a Native render
+static QString nativeRenderKey(const NativeOptions *O)
+{
+    const lcPreferences &Preferences = gui->GetPreferences();
+    QString key = QString("%1_%2_%3_%4_%5_%6_%7_%8_%9")
+                          .arg(O->ImageWidth).arg(O->ImageHeight)
+                          .arg(O->PageWidth).arg(O->PageHeight)
+                          .arg(double(O->Resolution)).arg(O->StudLogo)
+                          .arg(double(O->LineWidth)).arg(O->CameraName)
+                          .arg(O->IsOrtho);
+    key += QString("_%1_%2_%3_%4_%5_%6_%7_%8_%9")
+                   .arg(double(O->FoV)).arg(double(O->Latitude))
+                   .arg(double(O->Longitude)).arg(double(O->CameraDistance))
+                   .arg(double(O->Target.x)).arg(double(O->Target.y))
+                   .arg(double(O->Target.z)).arg(double(O->ModelScale))
+                   .arg(Preferences.mNativeViewpoint);
+    key += QString("_%1_%2_%3_%4")
+                   .arg(Preferences.mNativeProjection)
+                   .arg(int(Preferences.mShadingMode))
+                   .arg(Preferences.mDrawEdgeLines)
+                   .arg(Preferences.mConditionalLines);
+    return key;
+}
+
+// rendered images are private cache files that LPub3D reads straight back,
+// so they are written with the fastest zlib level rather than the default
+#define CACHE_IMAGE_COMPRESSION 1
+
+static void setCacheImageWriter(QImageWriter &Writer)
+{
+    if (Writer.format().isEmpty())
+        Writer.setFormat("PNG");
+    Writer.setCompression(CACHE_IMAGE_COMPRESSION);
+}
+
 // renderer timeout in milliseconds
 int Render::rendererTimeout(){
     if (Preferences::rendererTimeout == -1)
@@ -91,6 +171,106 @@ int Render::rendererTimeout(){
         return Preferences::rendererTimeout*60*1000;
 }
 
+// external renderer supervision - a crashed render is restarted, and a
+// POV-Ray render that runs well past the time it usually takes without
+// writing any progress output is treated as hung, killed and restarted.
+// LDView and LDGLite print almost nothing while rendering, so they are
+// only stopped by the configured renderer timeout.
+#define RENDER_POLL_INTERVAL    250   // msec between progress checks
+#define RENDER_STALL_MINIMUM  60000   // msec without output before a render can be stalled
+#define RENDER_STALL_FACTOR       4   // times the expected render time before a quiet render is stalled
+#define RENDER_RETRY_LIMIT        1   // restarts for a stalled or crashed render
+
+static QHash<QString, qint64> renderDurations;  // renderer and image type, average msec
+static QStringList renderFailures;              // failed render jobs of the current export
+
+bool Render::waitForRenderer(QProcess &process, const QString &logName, Options::Mt module, const QString &job)
+{
+    const QString renderKey = QString("%1_%2").arg(logName).arg(module);
+    const QStringList outputFiles = QStringList()
+            << QDir::currentPath() + "/stderr-" + logName
+            << QDir::currentPath() + "/stdout-" + logName;
+    const int timeout = rendererTimeout();
+    const qint64 expected = renderDurations.value(renderKey, 0);
+    const bool streamsProgress = logName == QLatin1String("povray");
+
+    QString failure;
+    for (int attempt = 0; attempt <= RENDER_RETRY_LIMIT; attempt++) {
+        if (attempt) {
+            emit gui->messageSig(LOG_NOTICE, QMessageBox::tr("Restarting %1 render after %2").arg(job).arg(failure));
+            process.start(process.program(), process.arguments());
+        }
+
+        QElapsedTimer elapsed, quiet;
+        elapsed.start();
+        quiet.start();
+        qint64 outputSize = -1;
+        bool stalled = false, timedOut = false;
+
+        while (!process.waitForFinished(RENDER_POLL_INTERVAL)) {
+            if (process.state() == QProcess::NotRunning)
+                break;
+            qint64 size = 0;
+            for (const QString &file : outputFiles)
+                size += QFileInfo(file).size();
+            if (size != outputSize) {
+                outputSize = size;
+                quiet.restart();
+            }
+            if (timeout != -1 && elapsed.elapsed() >= timeout) {
+                timedOut = true;
+                break;
+            }
+            if (streamsProgress && expected > 0 && elapsed.elapsed() > expected * RENDER_STALL_FACTOR &&
+                quiet.elapsed() > RENDER_STALL_MINIMUM) {
+                stalled = true;
+                break;
+            }
+        }
+
+        if (!stalled && !timedOut && process.error() != QProcess::FailedToStart &&
+            process.exitStatus() == QProcess::NormalExit) {
+            const qint64 duration = elapsed.elapsed();
+            renderDurations.insert(renderKey, expected ? (expected * 3 + duration) / 4 : duration);
+            return true;
+        }
+
+        if (process.state() != QProcess::NotRunning) {
+            process.kill();
+            process.waitForFinished();
+        }
+
+        if (timedOut) {
+            failure = QMessageBox::tr("timeout after %1 minutes").arg(Preferences::rendererTimeout);
+            break;
+        } else if (process.error() == QProcess::FailedToStart) {
+            failure = QMessageBox::tr("failed to start");
+            break;
+        }
+        failure = stalled ? QMessageBox::tr("no progress for %1 seconds").arg(quiet.elapsed() / 1000)
+                          : QMessageBox::tr("crash");
+    }
+
+    renderFailures << QString("%1 - %2").arg(job).arg(failure);
+    emit gui->messageSig(LOG_ERROR, QMessageBox::tr("%1 render failed: %2").arg(job).arg(failure));
+    return false;
+}
+
+void Render::clearRenderFailures()
+{
+    renderFailures.clear();
+}
+
+// log the render jobs that failed during an export
+void Render::reportRenderFailures()
+{
+    if (renderFailures.isEmpty())
+        return;
+    emit gui->messageSig(LOG_ERROR, QMessageBox::tr("%1 render job(s) failed during export:<br>%2")
+                         .arg(renderFailures.size()).arg(renderFailures.join("<br>")));
+    renderFailures.clear();
+}
+
 const QString Render::fixupDirname(const QString &dirNameIn) {
 #ifdef Q_OS_WIN
     long     length = 0;
@@ -265,26 +445,11 @@ bool Render::useLDViewSList(){
 bool Render::clipImage(QString const &pngName) {
 
     QImage toClip(QDir::toNativeSeparators(pngName));
-    QRect clipBox;
-
-    int minX = toClip.width(); int maxX = 0;
-    int minY = toClip.height();int maxY = 0;
+    QRect clipBox = lcGetImageAlphaBounds(toClip);
 
-    for(int x=0; x < toClip.width(); x++)
-        for(int y=0; y < toClip.height(); y++)
-            if (qAlpha(toClip.pixel(x, y)))
-            {
-                minX = qMin(x, minX);
-                minY = qMin(y, minY);
-                maxX = qMax(x, maxX);
-                maxY = qMax(y, maxY);
-            }
-
-    if (minX > maxX || minY > maxY) {
+    if (clipBox.left() > clipBox.right() || clipBox.top() > clipBox.bottom()) {
         emit gui->messageSig(LOG_STATUS, qPrintable("No opaque content in " + pngName));
         return false;
-    } else {
-        clipBox.setCoords(minX, minY, maxX, maxY);
     }
 
     //save clipBox;
@@ -295,8 +460,7 @@ bool Render::clipImage(QString const &pngName) {
                               .arg(clippedImage.height());
 
     QImageWriter Writer(QDir::toNativeSeparators(pngName));
-    if (Writer.format().isEmpty())
-            Writer.setFormat("PNG");
+    setCacheImageWriter(Writer);
 
     if (Writer.write(clippedImage)) {
         emit gui->messageSig(LOG_STATUS, QString("Clipped image saved '%1'")
@@ -535,7 +699,7 @@ int Render::executeLDViewProcess(QStringList &arguments, Options::Mt module) {
   ldview.setStandardOutputFile(QDir::currentPath() + "/stdout-ldview");
 
   ldview.start(Preferences::ldviewExe,arguments);
-  if ( ! ldview.waitForFinished(rendererTimeout())) {
+  if ( ! waitForRenderer(ldview, "ldview", module, QString("LDView %1").arg(module == Options::CSI ? "CSI" : "PLI"))) {
       if (ldview.exitCode() != 0 || 1) {
           QByteArray status = ldview.readAll();
           QString str;
@@ -793,7 +957,7 @@ int POVRay::renderCsi(
 #endif
 
       ldview.start(Preferences::ldviewExe,arguments);
-      if ( ! ldview.waitForFinished(rendererTimeout())) {
+      if ( ! waitForRenderer(ldview, "ldviewpov", Options::CSI, QString("LDView POV CSI %1").arg(QFileInfo(pngName).fileName()))) {
           if (ldview.exitCode() != 0 || 1) {
               QByteArray status = ldview.readAll();
               QString str;
@@ -910,8 +1074,8 @@ int POVRay::renderCsi(
 #endif
 
   povray.start(Preferences::povrayExe,povArguments);
-  if ( ! povray.waitForFinished(rendererTimeout())) {
-      if (povray.exitCode() != 0) {
+  if ( ! waitForRenderer(povray, "povray", Options::CSI, QString("POVRay CSI %1").arg(QFileInfo(pngName).fileName()))) {
+      if (povray.exitStatus() != QProcess::NormalExit || povray.exitCode() != 0) {
           QByteArray status = povray.readAll();
           QString str;
           str.append(status);
@@ -1137,8 +1301,8 @@ int POVRay::renderPli(
 #endif
 
       ldview.start(Preferences::ldviewExe,arguments);
-      if ( ! ldview.waitForFinished()) {
-          if (ldview.exitCode() != 0) {
+      if ( ! waitForRenderer(ldview, "ldviewpov", Options::PLI, QString("LDView POV PLI %1").arg(QFileInfo(pngName).fileName()))) {
+          if (ldview.exitCode() != 0 || 1) {
               QByteArray status = ldview.readAll();
               QString str;
               str.append(status);
@@ -1256,8 +1420,8 @@ int POVRay::renderPli(
 #endif
 
   povray.start(Preferences::povrayExe, povArguments);
-  if ( ! povray.waitForFinished(rendererTimeout())) {
-      if (povray.exitCode() != 0) {
+  if ( ! waitForRenderer(povray, "povray", Options::PLI, QString("POVRay PLI %1").arg(QFileInfo(pngName).fileName()))) {
+      if (povray.exitStatus() != QProcess::NormalExit || povray.exitCode() != 0) {
           QByteArray status = povray.readAll();
           QString str;
           str.append(status);
@@ -1418,8 +1582,8 @@ int LDGLite::renderCsi(
 #endif
 
   ldglite.start(Preferences::ldgliteExe,arguments);
-  if ( ! ldglite.waitForFinished(rendererTimeout())) {
-    if (ldglite.exitCode() != 0) {
+  if ( ! waitForRenderer(ldglite, "ldglite", Options::CSI, QString("LDGLite CSI %1").arg(QFileInfo(pngName).fileName()))) {
+    if (ldglite.exitStatus() != QProcess::NormalExit || ldglite.exitCode() != 0) {
       QByteArray status = ldglite.readAll();
       QString str;
       str.append(status);
@@ -1578,8 +1742,8 @@ int LDGLite::renderPli(
 #endif
 
   ldglite.start(Preferences::ldgliteExe,arguments);
-  if (! ldglite.waitForFinished(rendererTimeout())) {
-    if (ldglite.exitCode()) {
+  if (! waitForRenderer(ldglite, "ldglite", Options::PLI, QString("LDGLite PLI %1").arg(QFileInfo(pngName).fileName()))) {
+    if (ldglite.exitStatus() != QProcess::NormalExit || ldglite.exitCode()) {
       QByteArray status = ldglite.readAll();
       QString str;
       str.append(status);
@@ -2624,6 +2788,11 @@ int Native::renderCsi(
   Options->LineWidth         = lineThickness;
   Options->HighlightNewParts = gui->suppressColourMeta(); //Preferences::enableHighlightStep;
 
+  // Render only the parts added since the previous step when possible.
+  if (!gui->exportingObjects() && !setIncrementalRender(Options)) {
+      return -1;
+  }
+
   // Set CSI project
   Project* CsiImageProject = new Project();
   gApplication->SetProject(CsiImageProject);
@@ -2807,6 +2976,18 @@ int Native::renderPli(
   Options->CameraDistance = camDistance > 0 ? camDistance : cameraDistance(meta,modelScale);
   Options->LineWidth      = HIGHLIGHT_LINE_WIDTH_DEFAULT;
 
+  // Composite the image from this part's colour layers when possible.
+  // A batch for the render workers renders each colour there instead.
+  int rc;
+  if (!RenderWorkers::batchOpen() && (rc = RenderNativeRecolor(Options)) != 0) {
+      return rc < 0 ? -1 : 0;
+  }
+
+  // Leave the render to the workers when the caller is batching part images
+  if (RenderWorkers::queue(Options)) {
+      return 0;
+  }
+
   // Set PLI project
   Project* PliImageProject = new Project();
   gApplication->SetProject(PliImageProject);
@@ -2891,6 +3072,7 @@ bool Render::ExecuteViewer(const NativeOptions *O, bool RenderImage/*false*/){
             arguments << QString("LineWidth: %1").arg(double(O->LineWidth));
             arguments << QString("TransBackground: %1").arg(O->TransBackground ? "True" : "False");
             arguments << QString("HighlightNewParts: %1").arg(O->HighlightNewParts ? "True" : "False");
+            arguments << QString("IncrementalRender: %1").arg(O->IncrementalRender ? "True" : "False");
         } else {
             arguments << QString("ViewerStepKey: %1").arg(O->ViewerStepKey);
             arguments << (O->ImageFileName.isEmpty() ? QString() : QString("ImageFileName: %1").arg(O->ImageFileName));
@@ -2950,7 +3132,13 @@ bool Render::ExecuteViewer(const NativeOptions *O, bool RenderImage/*false*/){
         View.SetCamera(Camera, false);
         View.SetContext(Context);
 
-        if ((rc = View.BeginRenderToImage(ImageWidth, ImageHeight))) {
+        const bool RetainFramebuffer = !O->IncrementKey.isEmpty();
+
+        View.SetIncrementalRender(O->IncrementalRender);
+
+        if ((rc = RetainFramebuffer ?
+                  View.BeginRenderToImage(ImageWidth, ImageHeight, &nativeIncrement.Framebuffer) :
+                  View.BeginRenderToImage(ImageWidth, ImageHeight))) {
 
             struct NativeImage
             {
@@ -2965,8 +3153,17 @@ bool Render::ExecuteViewer(const NativeOptions *O, bool RenderImage/*false*/){
 
             Image.RenderedImage = View.GetRenderImage();
 
+            // translucent parts must be drawn after all opaque parts so
+            // the next step cannot be drawn over this image
+            if (RetainFramebuffer)
+                nativeIncrement.Valid = !View.IsTiledRender() && !View.HasTranslucentMeshes();
+
             View.EndRenderToImage();
 
+            // the framebuffer is only retained when the context supports it
+            if (RetainFramebuffer)
+                nativeIncrement.Valid &= nativeIncrement.Framebuffer.first.mColorTexture != 0;
+
             Context->ClearResources();
 
             ActiveModel->SetTemporaryStep(CurrentStep);
@@ -2988,26 +3185,7 @@ bool Render::ExecuteViewer(const NativeOptions *O, bool RenderImage/*false*/){
 
                 } else {
 
-                    int MinX = Width;
-                    int MinY = Height;
-                    int MaxX = 0;
-                    int MaxY = 0;
-
-                    for (int x = 0; x < Width; x++)
-                    {
-                        for (int y = 0; y < Height; y++)
-                        {
-                            if (qAlpha(RenderedImage.pixel(x, y)))
-                            {
-                                MinX = qMin(x, MinX);
-                                MinY = qMin(y, MinY);
-                                MaxX = qMax(x, MaxX);
-                                MaxY = qMax(y, MaxY);
-                            }
-                        }
-                    }
-
-                    Image.Bounds = QRect(QPoint(MinX, MinY), QPoint(MaxX, MaxY));
+                    Image.Bounds = lcGetImageAlphaBounds(RenderedImage);
                 }
             };
 
@@ -3015,8 +3193,7 @@ bool Render::ExecuteViewer(const NativeOptions *O, bool RenderImage/*false*/){
 
             QImageWriter Writer(O->OutputFileName);
 
-            if (Writer.format().isEmpty())
-                Writer.setFormat("PNG");
+            setCacheImageWriter(Writer);
 
             if (!Writer.write(QImage(Image.RenderedImage.copy(Image.Bounds))))
             {
@@ -3040,6 +3217,9 @@ bool Render::ExecuteViewer(const NativeOptions *O, bool RenderImage/*false*/){
 
             lcGetActiveProject()->SetImageSize(Image.Bounds.width(), Image.Bounds.height());
 
+        } else if (O->IncrementalRender) {
+            emit gui->messageSig(LOG_NOTICE,QMessageBox::tr("Native %1 previous step image could not be restored - "
+                                                            "rendering the complete step.").arg(ImageType));
         } else {
             emit gui->messageSig(LOG_ERROR,QMessageBox::tr("BeginRenderToImage for Native %1 image returned code %2.<br>"
                                                            "Render framebuffer is not valid").arg(ImageType).arg(rc));
@@ -3056,12 +3236,425 @@ bool Render::ExecuteViewer(const NativeOptions *O, bool RenderImage/*false*/){
     return rc;
 }
 
+bool Render::setIncrementalRender(NativeOptions *O)
+{
+    O->IncrementalRender = false;
+    O->IncrementKey      = QString();
+
+    // fade and highlight change the colour of previous step parts, and a
+    // zoom extent viewpoint would only fit the camera to the added parts
+    const bool viewpointZoomExtent = gui->GetPreferences().mNativeViewpoint <= 6 &&
+                                     lcGetProfileInt(LC_PROFILE_VIEWPOINT_ZOOM_EXTENT);
+    if (Preferences::enableFadeSteps || Preferences::enableHighlightStep || O->HighlightNewParts ||
+        viewpointZoomExtent) {
+        nativeIncrement.Valid = false;
+        return true;
+    }
+
+    QFile file(O->InputFileName);
+    if (!file.open(QFile::ReadOnly | QFile::Text)) {
+        emit gui->messageSig(LOG_ERROR,QMessageBox::tr("Cannot read Native CSI file %1: %2")
+                             .arg(O->InputFileName).arg(file.errorString()));
+        return false;
+    }
+
+    QStringList lines;
+    QTextStream in(&file);
+    while (!in.atEnd())
+        lines << in.readLine();
+    file.close();
+
+    // split the main model geometry (line types 1-5) from everything else
+    QStringList geometry, meta;
+    QVector<int> geometryIndex;
+    bool mainModel = true;
+    for (int i = 0; i < lines.size(); i++) {
+        const QString &line = lines.at(i);
+        const QString type  = line.trimmed().left(1);
+        if (mainModel && type >= "1" && type <= "5") {
+            geometry << line;
+            geometryIndex << i;
+        } else {
+            meta << line;
+            if (line.startsWith("0 NOFILE"))
+                mainModel = false;
+        }
+    }
+
+    O->IncrementKey = nativeRenderKey(O);
+
+    // the previous step must be a strict prefix of this step - removed
+    // or replaced parts (e.g. BuildMod) and changed meta force a full render
+    const int previousCount = nativeIncrement.Geometry.size();
+    const bool incremental  = nativeIncrement.Valid &&
+                              !nativeIncrementMismatch.contains(O->IncrementKey) &&
+                              nativeIncrement.Key == O->IncrementKey &&
+                              nativeIncrement.Meta == meta &&
+                              geometry.size() > previousCount &&
+                              geometry.mid(0, previousCount) == nativeIncrement.Geometry;
+
+    nativeIncrement.Key      = O->IncrementKey;
+    nativeIncrement.Geometry = geometry;
+    nativeIncrement.Meta     = meta;
+    nativeIncrement.Valid    = false;
+
+    if (!incremental)
+        return true;
+
+    for (int i = previousCount - 1; i >= 0; i--)
+        lines.removeAt(geometryIndex.at(i));
+
+    QString ldrName = QFileInfo(O->InputFileName).absolutePath() + "/csi_increment.ldr";
+    QFile incrementFile(ldrName);
+    if (!incrementFile.open(QFile::WriteOnly | QFile::Text)) {
+        emit gui->messageSig(LOG_ERROR,QMessageBox::tr("Cannot open file %1 for writing: %2")
+                             .arg(ldrName).arg(incrementFile.errorString()));
+        return false;
+    }
+
+    QTextStream out(&incrementFile);
+    for (const QString &line : lines)
+        out << line << endl;
+    incrementFile.close();
+
+    nativeIncrement.InputFileName = O->InputFileName;
+
+    O->InputFileName     = ldrName;
+    O->IncrementalRender = true;
+
+    return true;
+}
+
+// Composite a main colour from the light and dark layers. The light layer
+// is the shaded main colour plus specular, the dark layer the specular
+// alone; pixels where they match are edge lines.
+static QImage nativeRecolor(const QImage &light, const QImage &dark, const lcColor &Color)
+{
+    QImage image(light.size(), QImage::Format_ARGB32);
+
+    const int colorRgb[3] = { int(Color.Value[0] * 255.0f), int(Color.Value[1] * 255.0f), int(Color.Value[2] * 255.0f) };
+    const float edgeScale[3] = { Color.Edge[0] / 0.2f, Color.Edge[1] / 0.2f, Color.Edge[2] / 0.2f };
+
+    for (int y = 0; y < image.height(); y++) {
+        const QRgb *l = reinterpret_cast<const QRgb *>(light.constScanLine(y));
+        const QRgb *d = reinterpret_cast<const QRgb *>(dark.constScanLine(y));
+        QRgb *dst = reinterpret_cast<QRgb *>(image.scanLine(y));
+
+        for (int x = 0; x < image.width(); x++) {
+            const int lc[3] = { qRed(l[x]), qGreen(l[x]), qBlue(l[x]) };
+            const int dc[3] = { qRed(d[x]), qGreen(d[x]), qBlue(d[x]) };
+            const bool edge = qMax(lc[0] - dc[0], qMax(lc[1] - dc[1], lc[2] - dc[2])) < 8;
+            int c[3];
+            for (int i = 0; i < 3; i++)
+                c[i] = edge ? qMin(255, int(lc[i] * edgeScale[i])) :
+                              qMin(255, (lc[i] - dc[i]) * colorRgb[i] / 255 + dc[i]);
+            dst[x] = qRgba(c[0], c[1], c[2], qAlpha(l[x]));
+        }
+    }
+
+    return image;
+}
+
+// true when a shortcut render is within NATIVE_IMAGE_TOLERANCE of the
+// direct render on all but NATIVE_IMAGE_MISMATCH pixels per thousand
+static bool nativeImagesMatch(const QImage &image, const QImage &direct)
+{
+    const QImage shortcut = image.convertToFormat(QImage::Format_ARGB32);
+    const QImage reference = direct.convertToFormat(QImage::Format_ARGB32);
+    if (shortcut.isNull() || shortcut.size() != reference.size())
+        return false;
+
+    qint64 mismatches = 0;
+    for (int y = 0; y < shortcut.height(); y++) {
+        const QRgb *c = reinterpret_cast<const QRgb *>(shortcut.constScanLine(y));
+        const QRgb *d = reinterpret_cast<const QRgb *>(reference.constScanLine(y));
+        for (int x = 0; x < shortcut.width(); x++) {
+            const int diff = qMax(qMax(qAbs(qRed(c[x]) - qRed(d[x])), qAbs(qGreen(c[x]) - qGreen(d[x]))),
+                                  qMax(qAbs(qBlue(c[x]) - qBlue(d[x])), qAbs(qAlpha(c[x]) - qAlpha(d[x]))));
+            if (diff > NATIVE_IMAGE_TOLERANCE)
+                mismatches++;
+        }
+    }
+
+    return mismatches * 1000 <= qint64(shortcut.width()) * shortcut.height() * NATIVE_IMAGE_MISMATCH;
+}
+
+void Render::clearIncrementalRender()
+{
+    // release the retained framebuffer attachments of the last CSI
+    if (nativeIncrement.Framebuffer.first.mColorTexture) {
+        View* ActiveView = gui->GetActiveView();
+        if (ActiveView && ActiveView->mContext) {
+            ActiveView->MakeCurrent();
+            ActiveView->mContext->DestroyRenderFramebuffer(nativeIncrement.Framebuffer);
+        }
+    }
+
+    nativeIncrement.Key.clear();
+    nativeIncrement.Geometry.clear();
+    nativeIncrement.Meta.clear();
+    nativeIncrement.InputFileName.clear();
+    nativeIncrement.Valid = false;
+    nativeIncrementVerified.clear();
+    nativeIncrementMismatch.clear();
+}
+
+/*
+ * Render the complete step behind the first incremental render of each
+ * camera and render setting and compare the two images. On a mismatch
+ * the complete step image is kept and these settings render complete
+ * steps from now on.
+ */
+bool Render::verifyIncrementalRender(const NativeOptions *O)
+{
+    NativeOptions StepOptions(*O);
+    StepOptions.InputFileName     = nativeIncrement.InputFileName;
+    StepOptions.OutputFileName    = QFileInfo(O->OutputFileName).absolutePath() + "/csi_increment_check.png";
+    StepOptions.IncrementalRender = false;
+
+    if (! gui->OpenProject(StepOptions.InputFileName) || ! ExecuteViewer(&StepOptions,true/*exportImage*/))
+        return true; // keep the incremental image, check again with the next step
+
+    if (nativeImagesMatch(QImage(O->OutputFileName), QImage(StepOptions.OutputFileName))) {
+        nativeIncrementVerified.insert(O->IncrementKey);
+        QFile::remove(StepOptions.OutputFileName);
+        return true;
+    }
+
+    emit gui->messageSig(LOG_NOTICE,QMessageBox::tr("Native incremental CSI render does not match the complete step %1 - "
+                                                    "rendering complete steps with these settings.")
+                                                    .arg(O->OutputFileName));
+    nativeIncrementMismatch.insert(O->IncrementKey);
+
+    QFile::remove(O->OutputFileName);
+    return QFile::rename(StepOptions.OutputFileName, O->OutputFileName);
+}
+
+int Render::RenderNativeRecolor(const NativeOptions *O)
+{
+    if (gui->exportingObjects() || O->ImageType != Options::PLI)
+        return 0;
+
+    QFile file(O->InputFileName);
+    if (!file.open(QFile::ReadOnly | QFile::Text))
+        return 0;
+
+    QStringList lines;
+    QTextStream in(&file);
+    while (!in.atEnd())
+        lines << in.readLine();
+    file.close();
+
+    // a single part line, without colour, fade or silhouette metas that
+    // the layer renders would not reproduce
+    int partLine = -1;
+    QStringList tokens;
+    for (int i = 0; i < lines.size(); i++) {
+        const QString &line = lines.at(i);
+        if (line.contains("!COLOUR") || line.contains("!FADE") || line.contains("!SILHOUETTE"))
+            return 0;
+        if (line.trimmed().startsWith("1 ")) {
+            if (partLine != -1)
+                return 0;
+            partLine = i;
+        }
+    }
+    if (partLine == -1)
+        return 0;
+
+    split(lines.at(partLine), tokens);
+    if (tokens.size() != 15 || gui->isSubmodel(tokens[14]))
+        return 0;
+
+    bool ok;
+    const quint32 colorCode = tokens[1].toUInt(&ok, 0);
+    if (!ok || tokens[1] == LDRAW_MAIN_MATERIAL_COLOUR || tokens[1] == LDRAW_EDGE_MATERIAL_COLOUR)
+        return 0;
+
+    // lcGetColorIndex would add an unknown colour code (e.g. an LPub fade
+    // or highlight colour only defined in the file) as a grey entry
+    int colorIndex = -1;
+    for (size_t ColorIdx = 0; ColorIdx < gColorList.size(); ColorIdx++) {
+        if (gColorList[ColorIdx].Code == colorCode) {
+            colorIndex = int(ColorIdx);
+            break;
+        }
+    }
+    if (colorIndex == -1)
+        return 0;
+
+    const lcColor Color = gColorList[colorIndex];
+    if (Color.Translucent)
+        return 0;
+
+    // the layers depend on the whole file - part transform, ROTSTEP and
+    // other lines - so only the part colour is left out of the key
+    QStringList keyTokens = tokens;
+    keyTokens[1] = LDRAW_MAIN_MATERIAL_COLOUR;
+    QStringList keyLines  = lines;
+    keyLines[partLine] = keyTokens.join(" ");
+    const QString key = QString(QCryptographicHash::hash(keyLines.join("\n").toUtf8(), QCryptographicHash::Sha1).toHex())
+                        + "_" + nativeRenderKey(O);
+    if (nativeFixedColorParts.contains(key))
+        return 0;
+
+    QImage image;
+
+    if (NativeColorLayers *layers = nativeColorLayers.object(key)) {
+        image = nativeRecolor(layers->Light, layers->Dark, Color);
+    } else {
+        // two layer renders only pay off from the second colour of a part
+        if (!nativeColorFirst.contains(key)) {
+            nativeColorFirst.insert(key, { colorIndex, O->OutputFileName });
+            return 0;
+        }
+        const NativeColorFirst first = nativeColorFirst.value(key);
+        if (first.ColorIndex == colorIndex || !QFileInfo(first.FileName).exists())
+            return 0;
+
+        // only parts drawn entirely in the main and edge colour, without textures
+        PieceInfo *Info = lcGetPiecesLibrary()->FindPiece(tokens[14].toLatin1().constData(), nullptr, false, false);
+        if (!Info || Info->IsTemporary()) {
+            nativeFixedColorParts.insert(key);
+            return 0;
+        }
+
+        lcGetPiecesLibrary()->LoadPieceInfo(Info, true, true);
+
+        bool recolorable = Info->GetMesh() != nullptr;
+        if (recolorable) {
+            const lcMesh *Mesh = Info->GetMesh();
+            for (int LodIdx = 0; LodIdx < LC_NUM_MESH_LODS && recolorable; LodIdx++) {
+                for (int SectionIdx = 0; SectionIdx < Mesh->mLods[LodIdx].NumSections; SectionIdx++) {
+                    const lcMeshSection &Section = Mesh->mLods[LodIdx].Sections[SectionIdx];
+                    if (Section.Texture || (Section.ColorIndex != gDefaultColor && Section.ColorIndex != gEdgeColor)) {
+                        recolorable = false;
+                        break;
+                    }
+                }
+            }
+        }
+
+        lcGetPiecesLibrary()->ReleasePieceInfo(Info);
+
+        if (!recolorable) {
+            nativeFixedColorParts.insert(key);
+            return 0;
+        }
+
+        // direct colours share the same fixed edge colour
+        QImage images[2];
+        const QString layerCodes[2] = { "0x2FFFFFF", "0x2000000" };
+        const QString layerNames[2] = { "light", "dark" };
+        for (int i = 0; i < 2; i++) {
+            const QString baseName = QFileInfo(O->InputFileName).absolutePath() + "/pli_" + layerNames[i];
+
+            QFile layerFile(baseName + ".ldr");
+            if (!layerFile.open(QFile::WriteOnly | QFile::Text)) {
+                emit gui->messageSig(LOG_NOTICE,QMessageBox::tr("Cannot open file %1 for writing: %2 - rendering part directly.")
+                                     .arg(layerFile.fileName()).arg(layerFile.errorString()));
+                return 0;
+            }
+
+            tokens[1] = layerCodes[i];
+            QTextStream out(&layerFile);
+            for (int j = 0; j < lines.size(); j++)
+                out << (j == partLine ? tokens.join(" ") : lines.at(j)) << endl;
+            layerFile.close();
+
+            NativeOptions Layer(*O);
+            Layer.InputFileName  = layerFile.fileName();
+            Layer.OutputFileName = baseName + ".png";
+
+            gApplication->SetProject(new Project());
+
+            if (!RenderNativeImage(&Layer)) {
+                nativeFixedColorParts.insert(key);
+                return 0;
+            }
+
+            images[i] = QImage(Layer.OutputFileName).convertToFormat(QImage::Format_ARGB32);
+        }
+
+        if (images[0].isNull() || images[0].size() != images[1].size()) {
+            nativeFixedColorParts.insert(key);
+            return 0;
+        }
+
+        // the layers must reproduce the direct render of the first colour
+        const QImage direct = QImage(first.FileName).convertToFormat(QImage::Format_ARGB32);
+        if (!nativeImagesMatch(nativeRecolor(images[0], images[1], gColorList[first.ColorIndex]), direct)) {
+            emit gui->messageSig(LOG_NOTICE,QMessageBox::tr("Native PLI colour layers do not match %1 - rendering part colours directly.")
+                                 .arg(first.FileName));
+            nativeColorFirst.remove(key);
+            nativeFixedColorParts.insert(key);
+            return 0;
+        }
+        nativeColorFirst.remove(key);
+
+        image = nativeRecolor(images[0], images[1], Color);
+
+        // QCache deletes an object costing more than its budget on insert
+        const int cost = images[0].width() * images[0].height() * 8 / 1024;
+        if (cost <= nativeColorLayers.maxCost()) {
+            NativeColorLayers *layers = new NativeColorLayers;
+            layers->Light = images[0];
+            layers->Dark  = images[1];
+            nativeColorLayers.insert(key, layers, cost);
+        }
+    }
+
+    QImageWriter Writer(O->OutputFileName);
+    setCacheImageWriter(Writer);
+
+    if (!Writer.write(image)) {
+        emit gui->messageSig(LOG_ERROR,QMessageBox::tr("Could not write to Native PLI image file %1: %2")
+                             .arg(O->OutputFileName).arg(Writer.errorString()));
+        return -1;
+    }
+
+    emit gui->messageSig(LOG_INFO,QMessageBox::tr("Native PLI image file recoloured '%1'")
+                         .arg(O->OutputFileName));
+
+    return 1;
+}
+
+void Render::clearRecolorCache()
+{
+    nativeColorLayers.clear();
+    nativeFixedColorParts.clear();
+    nativeColorFirst.clear();
+}
+
 bool Render::RenderNativeImage(const NativeOptions *Options)
 {
+    // CSI renders stay in process where they can render incrementally
+    if (RenderWorkers::running() && Options->ImageType != Options::CSI &&
+        Options->ExportMode == EXPORT_NONE && Options->IncrementKey.isEmpty())
+        return RenderWorkers::render(Options);
+
     if (! gui->OpenProject(Options->InputFileName))
         return false;
 
-    return ExecuteViewer(Options,true/*exportImage*/);
+    if (ExecuteViewer(Options,true/*exportImage*/)) {
+        if (Options->IncrementalRender && !nativeIncrementVerified.contains(Options->IncrementKey))
+            return verifyIncrementalRender(Options);
+        return true;
+    }
+
+    // the retained framebuffer of the previous step was lost - render the complete step
+    if (Options->IncrementalRender && !nativeIncrement.InputFileName.isEmpty()) {
+        NativeOptions StepOptions(*Options);
+        StepOptions.InputFileName     = nativeIncrement.InputFileName;
+        StepOptions.IncrementalRender = false;
+
+        if (! gui->OpenProject(StepOptions.InputFileName))
+            return false;
+
+        return ExecuteViewer(&StepOptions,true/*exportImage*/);
+    }
+
+    return false;
 }
 
 bool Render::LoadViewer(const ViewerOptions *Options){
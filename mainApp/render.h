@@ -34,6 +34,7 @@
 
 class QString;
 class QStringList;
+class QProcess;
 class Meta;
 class AssemMeta;
 class LPubMeta;
@@ -53,6 +54,12 @@ public:
   static bool            useLDViewSCall();
   static bool            useLDViewSList();
   static int             rendererTimeout();
+  static bool            waitForRenderer(QProcess &process,
+                                         const QString &logName,
+                                         Options::Mt module,
+                                         const QString &job);
+  static void            clearRenderFailures();
+  static void            reportRenderFailures();
   static int             getRendererIndex();
   static int             getViewerPieces();
   static void            setRenderer(QString const &);
@@ -67,9 +74,14 @@ public:
   static void            showLdvExportSettings(int mode);
   static void            showLdvLDrawPreferences(int mode);
   static bool            RenderNativeImage(const NativeOptions *);
+  static int             RenderNativeRecolor(const NativeOptions *);
+  static void            clearRecolorCache();
   static bool            NativeExport(const NativeOptions *);
   static float           ViewerCameraDistance(Meta &meta, float);
   static bool            ExecuteViewer(const NativeOptions *, bool RenderImage = false);
+  static bool            setIncrementalRender(NativeOptions *);
+  static void            clearIncrementalRender();
+  static bool            verifyIncrementalRender(const NativeOptions *);
   static bool            LoadViewer(const ViewerOptions *);
   static QStringList const getImageAttributes(const QString &);
   static bool            compareImageAttributes(const QStringList &,
@@ -0,0 +1,422 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public Liceense (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "renderworkers.h"
+
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMessageBox>
+#include <QProcess>
+#include <QQueue>
+#include <QVector>
+
+#include "lpub.h"
+#include "render.h"
+#include "paths.h"
+#include "application.h"
+
+#include "project.h"
+
+QList<RenderWorkers::Worker> RenderWorkers::workers;
+QStringList                  RenderWorkers::workerArguments;
+QList<RenderWorkers::Job>    RenderWorkers::batch;
+bool                         RenderWorkers::batching = false;
+bool                         RenderWorkers::inProcess = false;
+
+/*
+ * Start count worker processes. The workers get our own command line
+ * arguments so they load the same parts library and render settings.
+ */
+bool RenderWorkers::start(int count, const QStringList &arguments)
+{
+    stop();
+
+    workerArguments = QStringList() << arguments << "-ns" << "--render-worker";
+
+    for (int i = 0; i < count; i++) {
+        Worker worker;
+        if (!launch(worker))
+            break;
+        workers.append(worker);
+    }
+
+    if (workers.isEmpty()) {
+        emit gui->messageSig(LOG_ERROR, QMessageBox::tr("Could not start Native render workers - rendering in process."));
+        return false;
+    }
+
+    emit gui->messageSig(LOG_INFO, QMessageBox::tr("Started %1 Native render worker(s).").arg(workers.size()));
+
+    return true;
+}
+
+void RenderWorkers::stop()
+{
+    for (Worker &worker : workers) {
+        if (worker.process->state() != QProcess::NotRunning) {
+            worker.process->closeWriteChannel();
+            if (!worker.process->waitForFinished(3000))
+                worker.process->kill();
+        }
+        delete worker.process;
+    }
+    workers.clear();
+    batch.clear();
+    batching = false;
+}
+
+bool RenderWorkers::running()
+{
+    return !workers.isEmpty() && !inProcess;
+}
+
+bool RenderWorkers::batchOpen()
+{
+    return batching;
+}
+
+bool RenderWorkers::launch(Worker &worker)
+{
+    if (!worker.process) {
+        worker.process = new QProcess();
+        worker.process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+        worker.process->setWorkingDirectory(QDir::currentPath());
+    }
+
+    worker.output.clear();
+    worker.job = -1;
+
+    worker.process->start(QCoreApplication::applicationFilePath(), workerArguments);
+    if (!worker.process->waitForStarted()) {
+        emit gui->messageSig(LOG_ERROR, QMessageBox::tr("Native render worker failed to start: %1")
+                             .arg(worker.process->errorString()));
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Render one image on a worker and wait for it.
+ */
+bool RenderWorkers::render(const NativeOptions *Options)
+{
+    QList<Job> jobs;
+    Job job;
+    job.request        = encode(Options, 0);
+    job.outputFileName = Options->OutputFileName;
+    jobs.append(job);
+
+    return run(jobs);
+}
+
+/*
+ * Collect the renders passed to queue() until endBatch() so they can
+ * run on all the workers at once.
+ */
+void RenderWorkers::beginBatch()
+{
+    batch.clear();
+    batching = running();
+}
+
+/*
+ * Add a render to the current batch. Returns false when no batch is
+ * open and the caller should render the image itself. The input file is
+ * copied because the caller reuses its name for the next job.
+ */
+bool RenderWorkers::queue(const NativeOptions *Options)
+{
+    if (!batching)
+        return false;
+
+    NativeOptions JobOptions(*Options);
+    JobOptions.InputFileName = QString("%1/%2/render_job_%3.ldr")
+                                .arg(QDir::currentPath())
+                                .arg(Paths::tmpDir)
+                                .arg(batch.size());
+    QFile::remove(JobOptions.InputFileName);
+    if (!QFile::copy(Options->InputFileName, JobOptions.InputFileName))
+        return false;
+
+    Job job;
+    job.request        = encode(&JobOptions, batch.size());
+    job.inputFileName  = JobOptions.InputFileName;
+    job.outputFileName = Options->OutputFileName;
+    batch.append(job);
+
+    return true;
+}
+
+/*
+ * Wait for the batched renders. Failed renders are reported here since
+ * the callers that queued them have already moved on.
+ */
+bool RenderWorkers::endBatch()
+{
+    batching = false;
+
+    if (batch.isEmpty())
+        return true;
+
+    bool ok = run(batch);
+
+    for (const Job &job : batch) {
+        if (!job.ok)
+            emit gui->messageSig(LOG_ERROR, QMessageBox::tr("Failed to render %1")
+                                 .arg(job.outputFileName));
+        QFile::remove(job.inputFileName);
+    }
+
+    batch.clear();
+
+    return ok;
+}
+
+/*
+ * Hand the jobs to idle workers until each job has a reply or has failed
+ * on RENDER_WORKER_ATTEMPTS workers. A worker that stops, or runs past the
+ * renderer timeout, is restarted and its job goes back on the queue.
+ * Jobs that did not render on a worker are rendered in process.
+ */
+bool RenderWorkers::run(QList<Job> &jobs)
+{
+    const int timeout = Render::rendererTimeout();
+
+    QQueue<int> queued;
+    for (int i = 0; i < jobs.size(); i++)
+        queued.enqueue(i);
+
+    QVector<QElapsedTimer> elapsed(workers.size());
+    int remaining = jobs.size();
+
+    while (remaining) {
+
+        // give the queued jobs to idle workers
+        int busy = 0;
+        for (int w = 0; w < workers.size(); w++) {
+            Worker &worker = workers[w];
+            if (worker.job == -1 && !queued.isEmpty()) {
+                if (worker.process->state() == QProcess::NotRunning && !launch(worker))
+                    continue;
+                worker.job = queued.dequeue();
+                jobs[worker.job].attempts++;
+                worker.process->write(jobs[worker.job].request + '\n');
+                elapsed[w].start();
+            }
+            if (worker.job != -1)
+                busy++;
+        }
+
+        // no worker could be started for the queued jobs
+        if (!busy)
+            break;
+
+        for (int w = 0; w < workers.size(); w++) {
+            Worker &worker = workers[w];
+            if (worker.job == -1)
+                continue;
+
+            worker.process->waitForReadyRead(RENDER_WORKER_POLL_INTERVAL);
+            worker.output += worker.process->readAllStandardOutput();
+
+            // worker console output is skipped, only reply lines are read
+            int eol;
+            while ((eol = worker.output.indexOf('\n')) != -1) {
+                const QByteArray line = worker.output.left(eol).trimmed();
+                worker.output.remove(0, eol + 1);
+                const QList<QByteArray> reply = line.split(' ');
+                if (reply.size() == 3 && reply[0] == RENDER_WORKER_REPLY &&
+                    reply[1].toInt() == worker.job) {
+                    jobs[worker.job].ok = reply[2] == "OK";
+                    if (!jobs[worker.job].ok)
+                        QFile::remove(jobs[worker.job].outputFileName);
+                    worker.job = -1;
+                    remaining--;
+                    break;
+                }
+            }
+
+            if (worker.job == -1)
+                continue;
+
+            const bool timedOut = timeout != -1 && elapsed[w].elapsed() > timeout;
+            if (worker.process->state() != QProcess::NotRunning && !timedOut)
+                continue;
+
+            if (timedOut) {
+                worker.process->kill();
+                worker.process->waitForFinished();
+            }
+
+            // drop any partly written image
+            Job &job = jobs[worker.job];
+            QFile::remove(job.outputFileName);
+            emit gui->messageSig(LOG_NOTICE, QMessageBox::tr("Native render worker %1 while rendering %2 - restarting worker.")
+                                 .arg(timedOut ? QMessageBox::tr("timed out") : QMessageBox::tr("stopped"))
+                                 .arg(job.outputFileName));
+
+            if (job.attempts < RENDER_WORKER_ATTEMPTS) {
+                queued.prepend(worker.job);
+            } else {
+                job.ok = false;
+                remaining--;
+            }
+            worker.job = -1;
+        }
+    }
+
+    bool ok = true;
+    for (Job &job : jobs) {
+        if (job.ok)
+            continue;
+        emit gui->messageSig(LOG_NOTICE, QMessageBox::tr("Rendering %1 in process.")
+                             .arg(job.outputFileName));
+        job.ok = renderInProcess(job);
+        ok &= job.ok;
+    }
+
+    return ok;
+}
+
+/*
+ * Render a job that failed on the workers here. running() is false
+ * meanwhile so RenderNativeImage does not hand it back to them.
+ */
+bool RenderWorkers::renderInProcess(const Job &job)
+{
+    NativeOptions Options;
+    int id = -1;
+    if (!decode(job.request, Options, id))
+        return false;
+
+    inProcess = true;
+    gApplication->SetProject(new Project());
+    const bool ok = Render::RenderNativeImage(&Options);
+    inProcess = false;
+
+    return ok;
+}
+
+QByteArray RenderWorkers::encode(const NativeOptions *Options, int id)
+{
+    QByteArray request;
+    QDataStream out(&request, QIODevice::WriteOnly);
+    out << qint32(id)
+        << qint32(Options->ImageType)
+        << Options->InputFileName
+        << Options->OutputFileName
+        << Options->CameraName
+        << qint32(Options->ImageWidth)
+        << qint32(Options->ImageHeight)
+        << qint32(Options->PageWidth)
+        << qint32(Options->PageHeight)
+        << qint32(Options->StudLogo)
+        << Options->Resolution
+        << Options->ModelScale
+        << Options->CameraDistance
+        << Options->FoV
+        << Options->Latitude
+        << Options->Longitude
+        << Options->IsOrtho
+        << Options->Target.x
+        << Options->Target.y
+        << Options->Target.z
+        << qint32(Options->IniFlag)
+        << Options->LineWidth
+        << Options->TransBackground
+        << Options->HighlightNewParts;
+    return request.toBase64();
+}
+
+bool RenderWorkers::decode(const QByteArray &request, NativeOptions &Options, int &id)
+{
+    QDataStream in(QByteArray::fromBase64(request));
+    qint32 jobId, imageType, imageWidth, imageHeight, pageWidth, pageHeight, studLogo, iniFlag;
+    float x, y, z;
+    in >> jobId
+       >> imageType
+       >> Options.InputFileName
+       >> Options.OutputFileName
+       >> Options.CameraName
+       >> imageWidth
+       >> imageHeight
+       >> pageWidth
+       >> pageHeight
+       >> studLogo
+       >> Options.Resolution
+       >> Options.ModelScale
+       >> Options.CameraDistance
+       >> Options.FoV
+       >> Options.Latitude
+       >> Options.Longitude
+       >> Options.IsOrtho
+       >> x >> y >> z
+       >> iniFlag
+       >> Options.LineWidth
+       >> Options.TransBackground
+       >> Options.HighlightNewParts;
+
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    id                  = jobId;
+    Options.ImageType   = Options::Mt(imageType);
+    Options.ImageWidth  = imageWidth;
+    Options.ImageHeight = imageHeight;
+    Options.PageWidth   = pageWidth;
+    Options.PageHeight  = pageHeight;
+    Options.StudLogo    = studLogo;
+    Options.IniFlag     = iniFlag;
+    Options.Target      = xyzVector(x, y, z);
+
+    return true;
+}
+
+/*
+ * --render-worker process loop. Render each job read from standard input
+ * until the main process closes the pipe.
+ */
+int RenderWorkers::exec()
+{
+    QFile input, output;
+    if (!input.open(stdin, QIODevice::ReadOnly) || !output.open(stdout, QIODevice::WriteOnly))
+        return 1;
+
+    emit gui->messageSig(LOG_INFO, QString("Native render worker ready."));
+
+    forever {
+        const QByteArray request = input.readLine().trimmed();
+        if (request.isEmpty() && input.atEnd())
+            break;
+        if (request.isEmpty())
+            continue;
+
+        NativeOptions Options;
+        int id = -1;
+        bool ok = decode(request, Options, id);
+        if (ok) {
+            gApplication->SetProject(new Project());
+            ok = Render::RenderNativeImage(&Options);
+        }
+
+        output.write(QString("%1 %2 %3\n").arg(RENDER_WORKER_REPLY).arg(id).arg(ok ? "OK" : "FAIL").toLatin1());
+        output.flush();
+    }
+
+    return 0;
+}
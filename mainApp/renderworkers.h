@@ -0,0 +1,92 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public Liceense (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+/****************************************************************************
+ *
+ * This class runs Native image renders on helper LPub3D processes started
+ * with --render-worker. Each worker loads its own parts library and render
+ * context once and then renders the jobs it reads from its standard input,
+ * one line per job, answering each with a reply line on standard output.
+ *
+ * Jobs are handed to idle workers. A worker that crashes or runs past the
+ * renderer timeout is restarted and its job is given to another worker,
+ * so a failing part render no longer ends the LPub3D session. A job that
+ * fails on the workers, or finds no worker to run on, is rendered in
+ * process, and a failed job has its partly written output file removed.
+ *
+ * Only part and submodel images are rendered on the workers. CSI images
+ * are rendered in process, which holds the previous step for incremental
+ * renders.
+ *
+ ***************************************************************************/
+
+#ifndef RENDERWORKERS_H
+#define RENDERWORKERS_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#define RENDER_WORKER_REPLY         "LPUB3D_RENDER_WORKER" // worker reply line prefix
+#define RENDER_WORKER_ATTEMPTS      2                      // workers a job is tried on before it fails
+#define RENDER_WORKER_POLL_INTERVAL 20                     // msec to wait on each busy worker
+
+class QProcess;
+class NativeOptions;
+
+class RenderWorkers
+{
+  public:
+    static bool start(int count, const QStringList &arguments);
+    static void stop();
+    static bool running();
+    static bool batchOpen();
+
+    static bool render(const NativeOptions *Options);
+    static void beginBatch();
+    static bool queue(const NativeOptions *Options);
+    static bool endBatch();
+
+    static int  exec();
+
+  private:
+    struct Job {
+      QByteArray request;
+      QString    inputFileName;  // job copy of the input, removed with the batch
+      QString    outputFileName;
+      int        attempts = 0;
+      bool       ok       = false;
+    };
+
+    struct Worker {
+      QProcess  *process = nullptr;
+      QByteArray output;
+      int        job     = -1;
+    };
+
+    static bool launch(Worker &worker);
+    static bool run(QList<Job> &jobs);
+    static bool renderInProcess(const Job &job);
+    static QByteArray encode(const NativeOptions *Options, int id);
+    static bool decode(const QByteArray &request, NativeOptions &Options, int &id);
+
+    static QList<Worker> workers;
+    static QStringList   workerArguments;
+    static QList<Job>    batch;
+    static bool          batching;
+    static bool          inProcess;
+};
+
+#endif // RENDERWORKERS_H
@@ -43,6 +43,8 @@
 #include "resolution.h"
 #include "dependencies.h"
 #include "paths.h"
+#include "partattributes.h"
+#include "pageimagecache.h"
 #include "ldrawfiles.h"
 #include <LDVQt/LDVImageMatte.h>
 
@@ -534,7 +536,7 @@ int Step::createCsi(
 
   // If not using LDView SCall, populate pixmap
   if (! renderer->useLDViewSCall()) {
-      pixmap->load(pngName);
+      *pixmap = PageImageCache::pixmap(pngName);
       csiPlacement.size[0] = pixmap->width();
       csiPlacement.size[1] = pixmap->height();
   }
@@ -579,6 +581,55 @@ void Step::getStepLocation(Where &top, Where &bottom) {
    }
 }
 
+/*
+ *
+ * Classify a line following an annotated part. Matches
+ * '0 !LPUB ASSEM ANNOTATION ICON ... <typeName|HIDDEN|HIDE> ...'
+ * taking the last of the names on the line, without building
+ * a per-part regular expression.
+ *
+ */
+Step::CsiAnnotationIcon Step::csiAnnotationIcon(
+    const QString &line,
+    const QString &typeName)
+{
+    static const QString iconMeta("LPUB ASSEM ANNOTATION ICON");
+
+    int i = 0;
+    while (i < line.size() && line.at(i).isSpace())
+        ++i;
+    if (i >= line.size() || line.at(i) != QLatin1Char('0'))
+        return NoAnnotationIcon;
+    if (++i >= line.size() || !line.at(i).isSpace())
+        return NoAnnotationIcon;
+    while (i < line.size() && line.at(i).isSpace())
+        ++i;
+    while (i < line.size() && line.at(i) == QLatin1Char('!'))
+        ++i;
+    if (line.midRef(i, iconMeta.size()) != iconMeta)
+        return NoAnnotationIcon;
+
+    const int from = i + iconMeta.size();
+    const int partAt = typeName.isEmpty() ? -1 : line.lastIndexOf(typeName);
+    const int hiddenAt = qMax(line.lastIndexOf(QLatin1String("HIDDEN")),
+                              line.lastIndexOf(QLatin1String("HIDE")));
+
+    if (partAt >= from && partAt >= hiddenAt)
+        return PartAnnotationIcon;
+    if (hiddenAt >= from)
+        return HiddenAnnotationIcon;
+
+    return NoAnnotationIcon;
+}
+
+/*
+ * Annotation parts computed per step, valid for one model version.
+ * A step whose content is unchanged since its last visit is neither
+ * rescanned nor written back.
+ */
+static QHash<QString, QStringList> csiAnnotationParts;
+static int csiAnnotationPartsVersion = -1;
+
 /*
  *
  * Place the CSI step annotation metas
@@ -597,6 +648,17 @@ void Step::setCsiAnnotationMetas(Meta &_meta, bool force)
     if (!meta->LPub.assem.annotation.display.value())
         return;
 
+    if (csiAnnotationPartsVersion != gui->modelVersion()) {
+        csiAnnotationParts.clear();
+        csiAnnotationPartsVersion = gui->modelVersion();
+    }
+
+    const Where stepTop = topOfStep();
+    const QString cacheKey = QString("%1:%2").arg(stepTop.modelName).arg(stepTop.lineNumber);
+    QHash<QString, QStringList>::const_iterator cached = csiAnnotationParts.constFind(cacheKey);
+    if (cached != csiAnnotationParts.constEnd() && ! force)
+        return;
+
     QHash<QString, PliPart*> pliParts;
 
     pli.getParts(pliParts);
@@ -642,16 +704,13 @@ void Step::setCsiAnnotationMetas(Meta &_meta, bool force)
 
             if (part->annotateText) {
                 QString typeName = QFileInfo(part->type).completeBaseName();
-                QString pattern = QString("^\\s*0\\s+(\\!*LPUB ASSEM ANNOTATION ICON).*("+typeName+"|HIDDEN|HIDE).*$");
-                QRegExp rx(pattern);
                 Where walk = start;
                 line = gui->readLine(++walk); // check next line - skip if meta exist
-                if (((line.contains(rx) && typeName == rx.cap(2)) ||
-                     (rx.cap(2) == "HIDDEN" || rx.cap(2) == "HIDE")) && ! force)
+                if (csiAnnotationIcon(line, typeName) != NoAnnotationIcon && ! force)
                     continue;
 
                 bool display = false;
-                AnnotationCategory annotationCategory = AnnotationCategory(Annotations::getAnnotationCategory(part->type));
+                AnnotationCategory annotationCategory = AnnotationCategory(PartAttributes::resolve(part->type).annotationCategory);
                 switch (annotationCategory)
                 {
                 case AnnotationCategory::axle:
@@ -692,9 +751,13 @@ void Step::setCsiAnnotationMetas(Meta &_meta, bool force)
             }
         }
     }
-    if (parts.size()){
+    // only write back when the computed annotations differ from the last visit
+    const bool changed = cached == csiAnnotationParts.constEnd() || cached.value() != parts;
+    if (parts.size() && changed){
         mi.writeCsiAnnotationMeta(parts,fromHere,toHere,meta,force);
     }
+    if (csiAnnotationPartsVersion == gui->modelVersion())
+        csiAnnotationParts.insert(cacheKey, parts);
 }
 
 /*
@@ -152,6 +152,11 @@ class Step : public AbstractRangeElement
 
     void setCsiAnnotationMetas(Meta &_meta,bool = false);
 
+    enum CsiAnnotationIcon { NoAnnotationIcon, PartAnnotationIcon, HiddenAnnotationIcon };
+    static CsiAnnotationIcon csiAnnotationIcon(
+            const QString &line,
+            const QString &typeName);
+
     void appendCsiAnnotation(
             const Where       &here,
             CsiAnnotationMeta &caMeta);
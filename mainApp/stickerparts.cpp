@@ -20,6 +20,7 @@
 #include <QFileInfo>
 #include <QTextStream>
 #include "lpub_preferences.h"
+#include "partattributes.h"
 #include "name.h"
 #include "version.h"
 #include "QsLog.h"
@@ -97,6 +98,7 @@ StickerParts::StickerParts()
                 }
             }
         }
+        PartAttributes::clear();
     }
 }
 
@@ -42,6 +42,7 @@
 #include "ranges_element.h"
 #include "range_element.h"
 #include "dependencies.h"
+#include "pageimagecache.h"
 
 #include "lc_qglwidget.h"
 #include "previewwidget.h"
@@ -402,7 +403,7 @@ int SubModel::createSubModelImage(
       viewerOptions->ImageHeight    = pixmap->height();
   }
 
-  pixmap->load(imageName);
+  *pixmap = PageImageCache::pixmap(imageName);
 
   return rc;
 }
@@ -36,6 +36,7 @@
 #include <QGraphicsItem>
 #include <QString>
 #include <QFileInfo>
+#include <QtConcurrent>
 #include "lpub_preferences.h"
 #include "ranges.h"
 #include "callout.h"
@@ -44,6 +45,7 @@
 #include "reserve.h"
 #include "step.h"
 #include "paths.h"
+#include "partattributes.h"
 #include "metaitem.h"
 #include "pointer.h"
 #include "pagepointer.h"
@@ -739,7 +741,7 @@ int Gui::drawPage(
 
           /* check if part is on excludedPart.lst and set pliIgnore*/
 
-          if (ExcludedParts::hasExcludedPart(type))
+          if (PartAttributes::resolve(type).excluded)
               pliIgnore = true;
 
           /* addition of ldraw parts */
@@ -754,7 +756,7 @@ int Gui::drawPage(
               if (! isSubmodel(type) || curMeta.LPub.pli.includeSubs.value()) {
 
                   /*  check if alternative part exist and replace */
-                  if(PliSubstituteParts::hasSubstitutePart(type)) {
+                  if(PartAttributes::resolve(type).substitute) {
 
                       QStringList substituteToken;
                       split(line,substituteToken);
@@ -2481,7 +2483,7 @@ int Gui::drawPage(
       }
       /* if part is on excludedPart.lst, unset pliIgnore if still set */
       if (pliIgnore && tokens[0] == "1" &&
-          ExcludedParts::hasExcludedPart(tokens[tokens.size()-1])) {
+          PartAttributes::resolve(tokens[tokens.size()-1]).excluded) {
           pliIgnore = false;
       }
     } // for every line
@@ -2515,6 +2517,8 @@ int Gui::findPage(
 
   emit messageSig(LOG_STATUS, "Processing find page for " + opts.current.modelName + "...");
 
+  const bool topOfModel = opts.current.lineNumber == 0;
+
   skipHeader(opts.current);
 
   if (opts.pageNum == 1) {
@@ -2581,6 +2585,11 @@ int Gui::findPage(
 
   ldrawFile.setRendered(opts.current.modelName, opts.isMirrored, opts.renderParentModel, stepNumber/*opts.groupStepNumber*/, countInstances);
 
+  // pages of a plain submodel away from the display page come from its scan
+  if (topOfModel && replaySubmodelPages(opts)) {
+      return 0;
+  }
+
   /*
    * For findPage(), the BuildMod behaviour captures the appropriate 'block' of lines
    * to be written to the csiPart list and writes the build mod action setting at each
@@ -2910,6 +2919,8 @@ int Gui::findPage(
                   if (Preferences::modeGUI && ! exporting()) {
                       emit messageSig(LOG_STATUS, QString("Counting document page %1...")
                                       .arg(QStringLiteral("%1").arg(opts.pageNum, 4, 10, QLatin1Char('0'))));
+                      if (displayPageNum > 0 && opts.pageNum > displayPageNum)
+                          setPageLineEdit->setText(QString("%1 of %2...") .arg(displayPageNum) .arg(opts.pageNum - 1));
                       QApplication::processEvents();
                   }
                 } // StepGroup
@@ -3089,6 +3100,8 @@ int Gui::findPage(
                       if (Preferences::modeGUI && ! exporting()) {
                           emit messageSig(LOG_STATUS, QString("Counting document page %1...")
                                           .arg(QStringLiteral("%1").arg(opts.pageNum, 4, 10, QLatin1Char('0'))));
+                          if (displayPageNum > 0 && opts.pageNum > displayPageNum)
+                              setPageLineEdit->setText(QString("%1 of %2...") .arg(displayPageNum) .arg(opts.pageNum - 1));
                           QApplication::processEvents();
                       }
                     } // ! StepGroup
@@ -3389,6 +3402,8 @@ int Gui::findPage(
       if (Preferences::modeGUI && ! exporting()) {
           emit messageSig(LOG_STATUS, QString("Counting document page %1...")
                           .arg(QStringLiteral("%1").arg(opts.pageNum, 4, 10, QLatin1Char('0'))));
+          if (displayPageNum > 0 && opts.pageNum > displayPageNum)
+              setPageLineEdit->setText(QString("%1 of %2...") .arg(displayPageNum) .arg(opts.pageNum - 1));
           QApplication::processEvents();
       }
     }  // Last Step in Submodel
@@ -3490,7 +3505,7 @@ int Gui::getBOMParts(
                     } else {
 
                       /*  check if alternative part exist and replace */
-                      if(PliSubstituteParts::hasSubstitutePart(type)) {
+                      if(PartAttributes::resolve(type).substitute) {
 
                           QStringList substituteToken;
                           split(line,substituteToken);
@@ -3842,9 +3857,215 @@ void Gui::attitudeAdjustment()
 }
 
 
-void Gui::countPages()
+/*
+ * Scan a submodel for the page structure findPage() would produce when it
+ * is entered at its first line with no continuous or group step numbering.
+ * Only submodels without submodel references and without meta commands
+ * that shape pages (LPub, buffer exchange, group, fade, colour and synth
+ * commands) are marked plain; their pages close at each STEP or ROTSTEP
+ * following parts, and at the end of the file.
+ */
+void Gui::scanSubmodelPageLines(const LDrawFileSnapshot &snapshot, SubmodelPageScan &scan)
 {
-  if (maxPages < 1) {
+  static const QStringList pageMetas = QStringList()
+      << "LPUB" << "CLEAR" << "FADE" << "SILHOUETTE" << "COLOUR" << "BUFEXCHG"
+      << "MLCAD" << "LDCAD" << "LEOCAD" << "SYNTH" << "PLIST";
+
+  const QStringList contents = snapshot.contents(scan.modelName);
+  scan.numLines = contents.size();
+  scan.plain    = false;
+
+  int partsAdded = 0;
+
+  for (int lineNumber = 0; lineNumber < contents.size(); lineNumber++) {
+
+      QString line = contents.at(lineNumber).trimmed();
+
+      if (line.startsWith("0 GHOST ")) {
+          line = line.mid(8).trimmed();
+      }
+
+      QStringList argv;
+
+      switch (line.isEmpty() ? 0 : line.at(0).toLatin1()) {
+      case '1':
+          split(line,argv);
+          if (argv.size() == 15 && snapshot.isSubmodel(argv[14])) {
+              return;
+          }
+          if (scan.firstPartPage == -1) {
+              scan.firstPartPage = scan.pageLines.size();
+          }
+          scan.lastPartPage = scan.pageLines.size();
+      case '2':
+      case '3':
+      case '4':
+      case '5':
+          ++partsAdded;
+          break;
+
+      case '0':
+          if (line.contains("CAMERA_DISTANCE_NATIVE")) {
+              return;
+          }
+          split(line,argv);
+          if (argv.size() < 2) {
+              break;
+          }
+          if (argv[1] == "STEP" || argv[1] == "ROTSTEP") {
+              if (argv[1] == "ROTSTEP") {
+                  bool ok[3];
+                  bool rotStep = argv.size() == 6;
+                  if (rotStep) {
+                      argv[2].toFloat(&ok[0]);
+                      argv[3].toFloat(&ok[1]);
+                      argv[4].toFloat(&ok[2]);
+                      rotStep = ok[0] && ok[1] && ok[2] &&
+                                (argv[5] == "ABS" || argv[5] == "REL" || argv[5] == "ADD");
+                  }
+                  if (! rotStep && ! (argv.size() == 3 && argv[2] == "END")) {
+                      return;  // malformed, leave the error report to the full walk
+                  }
+              }
+              if (partsAdded) {
+                  scan.pageLines.append(lineNumber);
+                  scan.stepPages++;
+                  partsAdded = 0;
+              }
+          } else {
+              QString keyword = argv[1].toUpper();
+              if (keyword.startsWith('!')) {
+                  keyword.remove(0,1);
+              }
+              if (pageMetas.contains(keyword)) {
+                  return;
+              }
+          }
+          break;
+      }
+  }
+
+  // last step in submodel
+  if (partsAdded) {
+      scan.pageLines.append(scan.numLines);
+  }
+
+  scan.plain = true;
+}
+
+/*
+ * Scan every submodel in parallel, once per model version.
+ */
+void Gui::scanSubmodelPages()
+{
+  if (submodelPageScanVersion == ldrawFile.version()) {
+      return;
+  }
+
+  submodelPageScans.clear();
+  submodelPageScanVersion = ldrawFile.version();
+
+  const LDrawFileSnapshot snapshot = ldrawFile.snapshot();
+
+  QVector<SubmodelPageScan> scans;
+  for (const QString &modelName : snapshot.subFileOrder()) {
+      if (snapshot.isSubmodel(modelName)) {
+          SubmodelPageScan scan;
+          scan.modelName = modelName;
+          scans.append(scan);
+      }
+  }
+
+  QtConcurrent::blockingMap(scans, [&snapshot](SubmodelPageScan &scan) {
+      scanSubmodelPageLines(snapshot, scan);
+  });
+
+  for (const SubmodelPageScan &scan : scans) {
+      submodelPageScans.insert(scan.modelName.toLower(), scan);
+  }
+}
+
+/*
+ * Advance the page count over a plain submodel from its scan instead of
+ * walking its lines. The walk is still used when the submodel holds the
+ * display page or when continuous or group step numbers are counted.
+ */
+bool Gui::replaySubmodelPages(FindPageOptions &opts)
+{
+  if (opts.contStepNumber || opts.groupStepNumber) {
+      return false;
+  }
+
+  scanSubmodelPages();
+
+  QHash<QString, SubmodelPageScan>::const_iterator it =
+          submodelPageScans.constFind(opts.current.modelName.toLower());
+  if (it == submodelPageScans.constEnd() || ! it.value().plain) {
+      return false;
+  }
+
+  const SubmodelPageScan &scan = it.value();
+  const int firstPage = opts.pageNum;
+  const int pages     = scan.pageLines.size();
+
+  if (displayPageNum >= firstPage && displayPageNum < firstPage + pages) {
+      return false;
+  }
+
+  const bool preDisplayPage = firstPage < displayPageNum;
+
+  if (scan.firstPartPage > -1) {
+      if (firstStepPageNum == -1) {
+          firstStepPageNum = firstPage + scan.firstPartPage;
+      }
+      lastStepPageNum = firstPage + scan.lastPartPage;
+  }
+
+  Where topOfPage = opts.current;
+  for (int i = 0; i < pages; i++) {
+      if (exporting()) {
+          pageSizes.remove(opts.pageNum);
+          pageSizes.insert(opts.pageNum,pageSizes[DEF_SIZE]);
+      }
+      ++opts.pageNum;
+      topOfPage.lineNumber = scan.pageLines.at(i);
+      topOfPages.append(topOfPage);
+      ++stepPageNum;
+      if (preDisplayPage && i < scan.stepPages) {
+          saveStepPageNum = stepPageNum;
+      }
+  }
+
+  opts.current.lineNumber = scan.numLines;
+
+  if (pages && Preferences::modeGUI && ! exporting()) {
+      emit messageSig(LOG_STATUS, QString("Counting document page %1...")
+                      .arg(QStringLiteral("%1").arg(opts.pageNum, 4, 10, QLatin1Char('0'))));
+      if (displayPageNum > 0 && opts.pageNum > displayPageNum)
+          setPageLineEdit->setText(QString("%1 of %2...") .arg(displayPageNum) .arg(opts.pageNum - 1));
+      QApplication::processEvents();
+  }
+
+  return true;
+}
+
+/*
+ * When provisional is set and the previous traversal left its page tops in
+ * topOfPages, take that as the page total instead of running a full count
+ * pass ahead of the page display. The next drawPage traversal publishes the
+ * new topOfPages as it goes, shows the requested page as soon as it is
+ * reached and settles maxPages when the count completes.
+ */
+void Gui::countPages(bool provisional)
+{
+  if (maxPages < 1 && provisional && Preferences::modeGUI && ! exporting() && topOfPages.size() > 1) {
+      maxPages             = topOfPages.size() - 1;
+      pageCountProvisional = true;
+      setPageLineEdit->setText(QString("%1 of %2...") .arg(displayPageNum) .arg(maxPages));
+      return;
+  }
+
+  if (maxPages < 1 || (pageCountProvisional && ! provisional)) {
       emit messageSig(LOG_TRACE, "Counting pages...");
       writeToTmp();
       Where current(ldrawFile.topLevelFile(),0);
@@ -3871,6 +4092,7 @@ void Gui::countPages()
       findPage(KpageView,KpageScene,meta,empty/*addLine*/,findOptions);
       topOfPages.append(current);
       maxPages--;
+      pageCountProvisional = false;
 
       if (displayPageNum > maxPages) {
           displayPageNum = maxPages;
@@ -3980,6 +4202,7 @@ void Gui::drawPage(
 */
 
       maxPages--;
+      pageCountProvisional = false;
 
       setCurrentStep();
 
@@ -4782,7 +5005,7 @@ QStringList Gui::configureModelSubFile(const QStringList &contents, const QStrin
               QString fileNameStr = QString(argv[argv.size()-1]).toLower();
               QString extension = QFileInfo(fileNameStr).suffix().toLower();
               // static color parts
-              if (ldrawColourParts.isLDrawColourPart(fileNameStr)){
+              if (PartAttributes::resolve(fileNameStr).colourPart){
                   if (extension.isEmpty()) {
                     fileNameStr = fileNameStr.append(QString("%1.ldr").arg(nameMod));
                   } else {
@@ -4829,6 +5052,106 @@ QStringList Gui::configureModelSubFile(const QStringList &contents, const QStrin
   return configuredContents;
 }
 
+/*
+ * Classify a csiParts line once - line type, part name, colour part and
+ * submodel status - so configureModelStep does not split and look up every
+ * accumulated part again at each step. The faded and highlighted renditions
+ * are kept with the classification once made. Classifications are dropped
+ * when the model contents change. The returned reference is only valid
+ * until the next call.
+ */
+Gui::CsiLineClass &Gui::classifyCsiLine(const QString &csiLine) {
+
+  if (csiLineClassVersion != ldrawFile.version()) {
+      csiLineClasses.clear();
+      csiLineClassVersion = ldrawFile.version();
+  }
+
+  QHash<QString, CsiLineClass>::iterator it = csiLineClasses.find(csiLine);
+  if (it != csiLineClasses.end())
+      return it.value();
+
+  CsiLineClass lc;
+  split(csiLine, lc.argv);
+
+  // determine line type
+  const QStringList &argv = lc.argv;
+  if (argv.size() && argv[0].size() == 1 &&
+      argv[0] >= "1" && argv[0] <= "5") {
+      lc.type_1_5_line = true;
+      if (argv.size() == 15 && argv[0] == "1")
+          lc.type_1_line = true;
+  }
+
+  // process parts naming
+  if (lc.type_1_line) {
+      lc.fileName = argv[argv.size()-1].toLower();
+      lc.extension = QFileInfo(lc.fileName).suffix().toLower();
+
+      // check if is color part
+      lc.is_colour_part = PartAttributes::resolve(lc.fileName).colourPart;
+
+      // check if is submodel
+      lc.is_submodel_file = ldrawFile.isSubmodel(lc.fileName);
+  }
+
+  QString line = csiLine;
+  lc.is_ghost = isGhost(line);
+
+  QStringList tokens = argv;
+  if (lc.is_ghost)
+      tokens.prepend(GHOST_META);
+  lc.line = tokens.join(" ");
+
+  return csiLineClasses.insert(csiLine, lc).value();
+}
+
+/*
+ * Make the faded or highlighted rendition of a classified type 1 to 5
+ * line - colourCode replaces the line colour and colour parts and
+ * submodels take their fade or highlight file name.
+ */
+QString Gui::colourCsiLine(const CsiLineClass &lc, const PartType partType, const QString &colourCode) {
+
+  const bool fadePartType = partType == FADE_PART;
+  const QString colourPrefix = fadePartType ? LPUB3D_COLOUR_FADE_PREFIX : LPUB3D_COLOUR_HIGHLIGHT_PREFIX;
+  const QString suffix = fadePartType ? FADE_SFX : HIGHLIGHT_SFX;
+
+  QStringList argv = lc.argv;
+  if (argv[1] != LDRAW_EDGE_MATERIAL_COLOUR &&
+      argv[1] != LDRAW_MAIN_MATERIAL_COLOUR) {
+      argv[1] = QString("%1%2").arg(colourPrefix).arg(colourCode);
+  }
+
+  if (lc.type_1_line) {
+      QString fileNameStr = lc.fileName;
+      const QString &extension = lc.extension;
+      // process static color part naming
+      if (lc.is_colour_part) {
+          if (extension.isEmpty()) {
+            fileNameStr = fileNameStr.append(QString("%1.dat").arg(suffix));
+          } else {
+            fileNameStr = fileNameStr.replace("."+extension, QString("%1.%2").arg(suffix).arg(extension));
+          }
+      }
+      // process subfiles naming
+      if (lc.is_submodel_file) {
+          if (extension.isEmpty()) {
+            fileNameStr = fileNameStr.append(QString("%1.ldr").arg(suffix));
+          } else {
+            fileNameStr = fileNameStr.replace("."+extension, QString("%1.%2").arg(suffix).arg(extension));
+          }
+      }
+      // assign fade or highlight part name
+      argv[argv.size()-1] = fileNameStr;
+  }
+
+  if (lc.is_ghost)
+      argv.prepend(GHOST_META);
+
+  return argv.join(" ");
+}
+
 /*
  * Process csiParts list - fade previous step-parts and or highlight current step-parts.
  * To get the previous content position, take the previous cisFile file size.
@@ -4838,6 +5161,7 @@ QStringList Gui::configureModelSubFile(const QStringList &contents, const QStrin
 QStringList Gui::configureModelStep(const QStringList &csiParts, const int &stepNum,  Where &current) {
 
   QStringList configuredCsiParts, stepColourList;
+  QSet<QString> fadeColourCodes, highlightColourCodes;
   bool doFadeStep  = page.meta.LPub.fadeStep.fadeStep.value();
   bool doHighlightStep = page.meta.LPub.highlightStep.highlightStep.value() && !suppressColourMeta();
   bool doHighlightFirstStep = Preferences::highlightFirstStep;
@@ -4858,133 +5182,76 @@ QStringList Gui::configureModelStep(const QStringList &csiParts, const int &step
 
       //qDebug() << "Model:" << current.modelName << ", Step:"  << stepNum << ", PrevStep Get Previous Step Position:" << prevStepPosition
       //         << ", CSI Size:" << csiParts.size() << ", Model Size:"  << ldrawFile.size(current.modelName);
-      QStringList argv;
 
       for (int index = 0; index < csiParts.size(); index++) {
 
-          bool type_1_line = false;
-          bool type_1_5_line = false;
-          bool is_colour_part = false;
-          bool is_submodel_file = false;
-
           int updatePosition = index+1;
           QString csiLine = csiParts[index];
-          split(csiLine, argv);
-
-          // determine line type
-          if (argv.size() && argv[0].size() == 1 &&
-              argv[0] >= "1" && argv[0] <= "5") {
-              type_1_5_line = true;
-              if (argv.size() == 15 && argv[0] == "1")
-                  type_1_line = true;
-          }
-
-          // process parts naming
-          QString fileNameStr, extension;
-          if (type_1_line){
-              fileNameStr = argv[argv.size()-1].toLower();
-              extension = QFileInfo(fileNameStr).suffix().toLower();
-
-              // check if is color part
-              is_colour_part = ldrawColourParts.isLDrawColourPart(fileNameStr);
 
-              // check if is submodel
-              is_submodel_file = ldrawFile.isSubmodel(fileNameStr);
-
-              //if (is_colour_part)
-              //    emit messageSig(LOG_NOTICE, "Static color part - " + fileNameStr);
+          CsiLineClass &lc = classifyCsiLine(csiLine);
+          const bool type_1_5_line = lc.type_1_5_line;
+
+          bool fadeLine = type_1_5_line &&
+                          (doHighlightFirstStep ? stepNum > 1 : true) && doFadeStep && (updatePosition <= prevStepPosition);
+          bool highlightLine = type_1_5_line &&
+                          doHighlightStep && (updatePosition > prevStepPosition);
+
+          // lines that are neither faded nor highlighted are written as classified
+          if (!fadeLine && !highlightLine) {
+              configuredCsiParts << lc.line;
+              if (updatePosition == prevStepPosition && FadeMetaAdded)
+                  configuredCsiParts.append(QString("0 !FADE"));
+              if (index+1 == csiParts.size() && SilhouetteMetaAdded)
+                  configuredCsiParts.append(QString("0 !SILHOUETTE"));
+              continue;
           }
 
-          // write fade step entries
-          if ((doHighlightFirstStep ? stepNum > 1 : true) && doFadeStep && (updatePosition <= prevStepPosition)) {
-              if (type_1_5_line) {
-                  // Insert opening fade meta
-                  if (!FadeMetaAdded && Preferences::enableFadeSteps){
-                     configuredCsiParts.insert(index,QString("0 !FADE %1").arg(Preferences::fadeStepsOpacity));
-                     FadeMetaAdded = true;
-                  }
-                  if (argv[1] != LDRAW_EDGE_MATERIAL_COLOUR &&
-                      argv[1] != LDRAW_MAIN_MATERIAL_COLOUR) {
-                      // generate fade color entry
-                      QString colourCode = Preferences::fadeStepsUseColour ? fadeColour : argv[1];
-                      if (!colourEntryExist(stepColourList,argv[1], FADE_PART))
-                        stepColourList << createColourEntry(colourCode, FADE_PART);
-                      // set fade color code
-                      argv[1] = QString("%1%2").arg(LPUB3D_COLOUR_FADE_PREFIX).arg(colourCode);
-                  }
-                  if (type_1_line) {
-                      // process static color part naming
-                      if (is_colour_part) {
-                          if (extension.isEmpty()) {
-                            fileNameStr = fileNameStr.append(QString("%1.dat").arg(FADE_SFX));
-                          } else {
-                            fileNameStr = fileNameStr.replace("."+extension, QString("%1.%2").arg(FADE_SFX).arg(extension));
-                          }
-                      }
-                      // process subfiles naming
-                      if (is_submodel_file) {
-                          if (extension.isEmpty()) {
-                            fileNameStr = fileNameStr.append(QString("%1.ldr").arg(FADE_SFX));
-                          } else {
-                            fileNameStr = fileNameStr.replace("."+extension, QString("%1.%2").arg(FADE_SFX).arg(extension));
-                          }
-                      }
-                      // assign fade part name
-                      argv[argv.size()-1] = fileNameStr;
+          const QString &colourCode = lc.argv[1];
+          const bool colourLine = colourCode != LDRAW_EDGE_MATERIAL_COLOUR &&
+                                  colourCode != LDRAW_MAIN_MATERIAL_COLOUR;
+
+          // write fade step entries - the faded rendition of a line is made
+          // once and reused at each following step
+          if (fadeLine) {
+              // Insert opening fade meta
+              if (!FadeMetaAdded && Preferences::enableFadeSteps){
+                 configuredCsiParts.insert(index,QString("0 !FADE %1").arg(Preferences::fadeStepsOpacity));
+                 FadeMetaAdded = true;
+              }
+              const QString fadeCode = Preferences::fadeStepsUseColour ? fadeColour : QString();
+              if (lc.fadeLine.isEmpty() || lc.fadeColour != fadeCode) {
+                  lc.fadeLine   = colourCsiLine(lc, FADE_PART, fadeCode.isEmpty() ? colourCode : fadeCode);
+                  lc.fadeColour = fadeCode;
+              }
+              // generate fade color entry
+              if (colourLine) {
+                  const QString entryCode = fadeCode.isEmpty() ? colourCode : fadeCode;
+                  if (!fadeColourCodes.contains(entryCode)) {
+                      fadeColourCodes.insert(entryCode);
+                      stepColourList << createColourEntry(entryCode, FADE_PART);
                   }
               }
+              configuredCsiParts << lc.fadeLine;
           }
           // write highlight entries
-          if (doHighlightStep && (updatePosition > prevStepPosition)) {
-              if (type_1_5_line) {
-                  // Insert opening silhouette meta
-                  if (!SilhouetteMetaAdded && Preferences::enableHighlightStep){
-                     configuredCsiParts.append(QString("0 !SILHOUETTE %1 %2")
-                                                       .arg(Preferences::highlightStepLineWidth)
-                                                       .arg(Preferences::highlightStepColour));
-                     SilhouetteMetaAdded = true;
-                  }
-                  if (argv[1] != LDRAW_EDGE_MATERIAL_COLOUR &&
-                      argv[1] != LDRAW_MAIN_MATERIAL_COLOUR) {
-                      // generate fade color entry
-                      QString colourCode = argv[1];
-                      if (!colourEntryExist(stepColourList,argv[1], HIGHLIGHT_PART))
-                        stepColourList << createColourEntry(colourCode, HIGHLIGHT_PART);
-                      // set fade color code
-                      argv[1] = QString("%1%2").arg(LPUB3D_COLOUR_HIGHLIGHT_PREFIX).arg(colourCode);
-                  }
-                  if (type_1_line) {
-                      // process static color part naming
-                      if (is_colour_part) {
-                          if (extension.isEmpty()) {
-                            fileNameStr = fileNameStr.append(QString("%1.dat").arg(HIGHLIGHT_SFX));
-                          } else {
-                            fileNameStr = fileNameStr.replace("."+extension, QString("%1.%2").arg(HIGHLIGHT_SFX).arg(extension));
-                          }
-                      }
-                      // process subfiles naming
-                      if (is_submodel_file) {
-                          if (extension.isEmpty()) {
-                            fileNameStr = fileNameStr.append(QString("%1.ldr").arg(HIGHLIGHT_SFX));
-                          } else {
-                            fileNameStr = fileNameStr.replace("."+extension, QString("%1.%2").arg(HIGHLIGHT_SFX).arg(extension));
-                          }
-                      }
-                      // assign fade part name
-                      argv[argv.size()-1] = fileNameStr;
-                  }
+          if (highlightLine) {
+              // Insert opening silhouette meta
+              if (!SilhouetteMetaAdded && Preferences::enableHighlightStep){
+                 configuredCsiParts.append(QString("0 !SILHOUETTE %1 %2")
+                                                   .arg(Preferences::highlightStepLineWidth)
+                                                   .arg(Preferences::highlightStepColour));
+                 SilhouetteMetaAdded = true;
               }
+              if (lc.highlightLine.isEmpty())
+                  lc.highlightLine = colourCsiLine(lc, HIGHLIGHT_PART, colourCode);
+              // generate highlight color entry
+              if (colourLine && !highlightColourCodes.contains(colourCode)) {
+                  highlightColourCodes.insert(colourCode);
+                  stepColourList << createColourEntry(colourCode, HIGHLIGHT_PART);
+              }
+              configuredCsiParts << lc.highlightLine;
           }
 
-          if (isGhost(csiLine))
-              argv.prepend(GHOST_META);
-
-          // previous step parts
-          csiLine = argv.join(" ");
-
-          // current step parts
-          configuredCsiParts  << csiLine;
-
           // Insert closing fade meta
           if (updatePosition == prevStepPosition) {
               if (FadeMetaAdded){